@@ -0,0 +1,314 @@
+#include <benchmark/benchmark.h>
+
+#include "memcpy_ptr_ring.h"
+#include "memcpy_shared_pointer.h"
+#include "memcpy_unique_pointer.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace
+{
+    // Typical small message: header plus a few samples
+    struct message
+    {
+        explicit message(uint32_t id) : id(id) {}
+        uint32_t id;
+        uint32_t samples[15] = {};
+    };
+
+    constexpr std::size_t ring_size = 64;
+
+    // Baseline queue for types that can only be moved (std::unique_ptr, std::shared_ptr, raw pointers)
+    template <class T, std::size_t N>
+    class move_ring
+    {
+    public:
+        bool push(T &item)
+        {
+            if (tail - head == N)
+            {
+                return false;
+            }
+            slots[tail++ % N] = std::move(item);
+            return true;
+        }
+
+        bool pop(T &out)
+        {
+            if (tail == head)
+            {
+                return false;
+            }
+            out = std::move(slots[head++ % N]);
+            return true;
+        }
+
+    private:
+        std::size_t head = 0;
+        std::size_t tail = 0;
+        T slots[N]{};
+    };
+
+    // --- Construction through the factories ---
+
+    void BM_make_memcpy_unique_ptr(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            auto ptr = make_memcpy_unique_ptr<message>(1u);
+            benchmark::DoNotOptimize(ptr.get());
+        }
+    }
+    BENCHMARK(BM_make_memcpy_unique_ptr);
+
+    void BM_make_std_unique_ptr(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            auto ptr = std::make_unique<message>(1u);
+            benchmark::DoNotOptimize(ptr.get());
+        }
+    }
+    BENCHMARK(BM_make_std_unique_ptr);
+
+    void BM_new_delete_raw(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            message *ptr = new message(1u);
+            benchmark::DoNotOptimize(ptr);
+            delete ptr;
+        }
+    }
+    BENCHMARK(BM_new_delete_raw);
+
+    void BM_make_memcpy_shared_ptr(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            auto ptr = make_memcpy_shared_ptr<message>(1u);
+            benchmark::DoNotOptimize(ptr.get());
+        }
+    }
+    BENCHMARK(BM_make_memcpy_shared_ptr);
+
+    void BM_make_memcpy_local_shared_ptr(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            auto ptr = make_memcpy_local_shared_ptr<message>(1u);
+            benchmark::DoNotOptimize(ptr.get());
+        }
+    }
+    BENCHMARK(BM_make_memcpy_local_shared_ptr);
+
+    void BM_make_std_shared_ptr(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            auto ptr = std::make_shared<message>(1u);
+            benchmark::DoNotOptimize(ptr.get());
+        }
+    }
+    BENCHMARK(BM_make_std_shared_ptr);
+
+    // --- Copy and move ---
+
+    void BM_copy_memcpy_shared_ptr(benchmark::State &state)
+    {
+        auto source = make_memcpy_shared_ptr<message>(1u);
+        for (auto _ : state)
+        {
+            memcpy_shared_ptr<message> copy = source;
+            benchmark::DoNotOptimize(copy.get());
+        }
+    }
+    BENCHMARK(BM_copy_memcpy_shared_ptr);
+
+    void BM_copy_memcpy_local_shared_ptr(benchmark::State &state)
+    {
+        auto source = make_memcpy_local_shared_ptr<message>(1u);
+        for (auto _ : state)
+        {
+            memcpy_local_shared_ptr<message> copy = source;
+            benchmark::DoNotOptimize(copy.get());
+        }
+    }
+    BENCHMARK(BM_copy_memcpy_local_shared_ptr);
+
+    void BM_copy_std_shared_ptr(benchmark::State &state)
+    {
+        auto source = std::make_shared<message>(1u);
+        for (auto _ : state)
+        {
+            std::shared_ptr<message> copy = source;
+            benchmark::DoNotOptimize(copy.get());
+        }
+    }
+    BENCHMARK(BM_copy_std_shared_ptr);
+
+    void BM_move_memcpy_unique_ptr(benchmark::State &state)
+    {
+        auto a = make_memcpy_unique_ptr<message>(1u);
+        memcpy_unique_ptr<message> b;
+        for (auto _ : state)
+        {
+            b = std::move(a);
+            a = std::move(b);
+            benchmark::DoNotOptimize(a.get());
+        }
+    }
+    BENCHMARK(BM_move_memcpy_unique_ptr);
+
+    void BM_move_std_unique_ptr(benchmark::State &state)
+    {
+        auto a = std::make_unique<message>(1u);
+        std::unique_ptr<message> b;
+        for (auto _ : state)
+        {
+            b = std::move(a);
+            a = std::move(b);
+            benchmark::DoNotOptimize(a.get());
+        }
+    }
+    BENCHMARK(BM_move_std_unique_ptr);
+
+    void BM_move_memcpy_shared_ptr(benchmark::State &state)
+    {
+        auto a = make_memcpy_shared_ptr<message>(1u);
+        memcpy_shared_ptr<message> b;
+        for (auto _ : state)
+        {
+            b = std::move(a);
+            a = std::move(b);
+            benchmark::DoNotOptimize(a.get());
+        }
+    }
+    BENCHMARK(BM_move_memcpy_shared_ptr);
+
+    void BM_move_std_shared_ptr(benchmark::State &state)
+    {
+        auto a = std::make_shared<message>(1u);
+        std::shared_ptr<message> b;
+        for (auto _ : state)
+        {
+            b = std::move(a);
+            a = std::move(b);
+            benchmark::DoNotOptimize(a.get());
+        }
+    }
+    BENCHMARK(BM_move_std_shared_ptr);
+
+    // --- memcpy_send / memcpy_receive round trips through a ring buffer ---
+
+    void BM_ring_round_trip_memcpy_unique_ptr(benchmark::State &state)
+    {
+        memcpy_spsc_ring<memcpy_unique_ptr<message>, ring_size> ring;
+        auto item = make_memcpy_unique_ptr<message>(1u);
+        for (auto _ : state)
+        {
+            ring.push(item);
+            ring.pop(item);
+            benchmark::DoNotOptimize(item.get());
+        }
+    }
+    BENCHMARK(BM_ring_round_trip_memcpy_unique_ptr);
+
+    void BM_ring_round_trip_memcpy_shared_ptr(benchmark::State &state)
+    {
+        memcpy_spsc_ring<memcpy_shared_ptr<message>, ring_size> ring;
+        auto item = make_memcpy_shared_ptr<message>(1u);
+        memcpy_shared_ptr<message> out;
+        for (auto _ : state)
+        {
+            ring.push(item);
+            ring.pop(out);
+            benchmark::DoNotOptimize(out.get());
+        }
+    }
+    BENCHMARK(BM_ring_round_trip_memcpy_shared_ptr);
+
+    void BM_ring_round_trip_memcpy_unique_ptr_mpsc(benchmark::State &state)
+    {
+        memcpy_mpsc_ring<memcpy_unique_ptr<message>, ring_size> ring;
+        auto item = make_memcpy_unique_ptr<message>(1u);
+        for (auto _ : state)
+        {
+            ring.push(item);
+            ring.pop(item);
+            benchmark::DoNotOptimize(item.get());
+        }
+    }
+    BENCHMARK(BM_ring_round_trip_memcpy_unique_ptr_mpsc);
+
+    void BM_ring_round_trip_std_unique_ptr(benchmark::State &state)
+    {
+        move_ring<std::unique_ptr<message>, ring_size> ring;
+        auto item = std::make_unique<message>(1u);
+        for (auto _ : state)
+        {
+            ring.push(item);
+            ring.pop(item);
+            benchmark::DoNotOptimize(item.get());
+        }
+    }
+    BENCHMARK(BM_ring_round_trip_std_unique_ptr);
+
+    void BM_ring_round_trip_std_shared_ptr(benchmark::State &state)
+    {
+        move_ring<std::shared_ptr<message>, ring_size> ring;
+        auto item = std::make_shared<message>(1u);
+        std::shared_ptr<message> out;
+        for (auto _ : state)
+        {
+            std::shared_ptr<message> copy = item; // Same ownership semantics as memcpy_send
+            ring.push(copy);
+            ring.pop(out);
+            benchmark::DoNotOptimize(out.get());
+        }
+    }
+    BENCHMARK(BM_ring_round_trip_std_shared_ptr);
+
+    void BM_ring_round_trip_raw_pointer(benchmark::State &state)
+    {
+        move_ring<message *, ring_size> ring;
+        message object(1u);
+        message *item = &object;
+        for (auto _ : state)
+        {
+            ring.push(item);
+            ring.pop(item);
+            benchmark::DoNotOptimize(item);
+        }
+    }
+    BENCHMARK(BM_ring_round_trip_raw_pointer);
+
+    // --- Contended reference-count churn, 1..N threads on one object ---
+
+    memcpy_shared_ptr<message> contended_memcpy = make_memcpy_shared_ptr<message>(1u);
+    std::shared_ptr<message> contended_std = std::make_shared<message>(1u);
+
+    void BM_contended_copy_memcpy_shared_ptr(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            memcpy_shared_ptr<message> copy = contended_memcpy;
+            benchmark::DoNotOptimize(copy.get());
+        }
+    }
+    BENCHMARK(BM_contended_copy_memcpy_shared_ptr)->ThreadRange(1, 8)->UseRealTime();
+
+    void BM_contended_copy_std_shared_ptr(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            std::shared_ptr<message> copy = contended_std;
+            benchmark::DoNotOptimize(copy.get());
+        }
+    }
+    BENCHMARK(BM_contended_copy_std_shared_ptr)->ThreadRange(1, 8)->UseRealTime();
+}
+
+BENCHMARK_MAIN();
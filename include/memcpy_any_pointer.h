@@ -0,0 +1,222 @@
+#pragma once
+
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // For memcpy
+#include <utility>
+
+#include "memcpy_unique_pointer.h"
+#include "memcpy_relocate.h"
+
+/**
+ * Per-type descriptor of a memcpy_any_unique_ptr payload. Its address is the type
+ * tag: every (T, Deleter) pair has its own object, so two types never compare equal,
+ * even if the linker folds their identical destroy functions.
+ */
+struct memcpy_any_type
+{
+    void (*destroy)(void *) noexcept;
+};
+
+template <class T, class Deleter>
+struct memcpy_any_type_of
+{
+    static void destroy(void *ptr) noexcept { Deleter{}(static_cast<T *>(ptr)); }
+
+    static constexpr memcpy_any_type descriptor{&destroy};
+};
+
+/**
+ * A type-erased memcpy_unique_ptr, so that one queue can carry every message type:
+ *
+ *     memcpy_any_unique_ptr msg;
+ *     msg.memcpy_receive(...);                        // one blocking receive for all types
+ *     if (Telemetry *t = msg.get_if<Telemetry>()) ...
+ *
+ * It is two pointers wide whatever the payload: the object and its type descriptor,
+ * which both tags the type and knows how to delete it. get_if is a single compare.
+ * memcpy_send, memcpy_receive and memcpy_adopt follow the memcpy_unique_ptr contract.
+ *
+ * Payloads come from memcpy_unique_ptr<T, Deleter> with a stateless Deleter (the
+ * default one, or a pool's); single objects only.
+ */
+class memcpy_any_unique_ptr
+{
+public:
+    // Creates an empty pointer
+    memcpy_any_unique_ptr() noexcept = default;
+
+    // Takes the object over from a typed pointer, which is left empty
+    template <class T, class Deleter>
+    memcpy_any_unique_ptr(memcpy_unique_ptr<T, Deleter> &&typed) noexcept
+    {
+        static_assert(!std::is_array<T>::value, "memcpy_any_unique_ptr does not carry arrays");
+        static_assert(std::is_empty<Deleter>::value && std::is_default_constructible<Deleter>::value,
+                      "memcpy_any_unique_ptr only erases stateless deleters");
+        ptr = typed.release();
+        if (ptr != nullptr)
+        {
+            type = &memcpy_any_type_of<T, Deleter>::descriptor;
+        }
+    }
+
+    // --- Ownership Rules ---
+    memcpy_any_unique_ptr(const memcpy_any_unique_ptr &obj) = delete;
+    memcpy_any_unique_ptr &operator=(const memcpy_any_unique_ptr &obj) = delete;
+
+    memcpy_any_unique_ptr(memcpy_any_unique_ptr &&dyingObj) noexcept : ptr(dyingObj.ptr), type(dyingObj.type)
+    {
+        dyingObj.ptr = nullptr;
+        dyingObj.type = nullptr;
+    }
+
+    memcpy_any_unique_ptr &operator=(memcpy_any_unique_ptr &&dyingObj) noexcept
+    {
+        if (this != &dyingObj)
+        {
+            reset();
+            ptr = dyingObj.ptr;
+            type = dyingObj.type;
+            dyingObj.ptr = nullptr;
+            dyingObj.type = nullptr;
+        }
+        return *this;
+    }
+
+    ~memcpy_any_unique_ptr() { reset(); }
+
+    // --- Accessors ---
+
+    // The payload if it is a T (released through Deleter), nullptr otherwise
+    template <class T, class Deleter = memcpy_default_delete<T>>
+    T *get_if() const noexcept
+    {
+        return holds<T, Deleter>() ? static_cast<T *>(ptr) : nullptr;
+    }
+
+    template <class T, class Deleter = memcpy_default_delete<T>>
+    bool holds() const noexcept
+    {
+        return type == &memcpy_any_type_of<T, Deleter>::descriptor;
+    }
+
+    // Type tag of the payload (nullptr when empty), e.g. for a switch over known descriptors
+    const memcpy_any_type *type_tag() const noexcept { return type; }
+
+    void *get() const noexcept { return ptr; }
+
+    explicit operator bool() const noexcept { return ptr != nullptr; }
+
+    /**
+     * Hands the payload back as a typed pointer if it is a T; otherwise returns an
+     * empty pointer and keeps the payload.
+     */
+    template <class T, class Deleter = memcpy_default_delete<T>>
+    memcpy_unique_ptr<T, Deleter> take_if() noexcept
+    {
+        if (!holds<T, Deleter>())
+        {
+            return memcpy_unique_ptr<T, Deleter>{};
+        }
+        T *const object = static_cast<T *>(ptr);
+        ptr = nullptr;
+        type = nullptr;
+        return memcpy_unique_ptr<T, Deleter>{object};
+    }
+
+    // Deletes the payload (if any)
+    void reset() noexcept
+    {
+        if (ptr != nullptr)
+        {
+            type->destroy(ptr);
+            ptr = nullptr;
+            type = nullptr;
+        }
+    }
+
+    // --- C-API Bridge Interface (SFINAE Guarded) ---
+
+    // Signature Requirement: bool func(void* dest, const memcpy_any_unique_ptr* src)
+    template <typename _Function>
+    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_any_unique_ptr *const>;
+
+    // Signature Requirement: bool func(memcpy_any_unique_ptr* dest, const void* src)
+    template <typename _Function>
+    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_any_unique_ptr *const, const void *const>;
+
+    /**
+     * Prepares the pointer for a bitwise send (e.g., xQueueSend).
+     * If the copy function succeeds the payload and its tag belong to the bits in
+     * 'dest' and this pointer is left empty.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_send_signature<_Function>, bool>::type
+    memcpy_send(void *const dest, _Function copy_fn_src)
+    {
+        bool success = false;
+        if (copy_fn_src(dest, this))
+        {
+            ptr = nullptr;
+            type = nullptr;
+            success = true;
+        }
+        return success;
+    }
+
+    /**
+     * Claims ownership from a bitwise source (e.g., xQueueReceive).
+     * An empty pointer is written in place; otherwise the bits land in a temporary
+     * buffer before the current payload is deleted. On failure the copy function must not write.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type
+    memcpy_receive(const void *const src, _Function copy_fn_dest)
+    {
+        if (ptr == nullptr)
+        {
+            return copy_fn_dest(this, src); // Nothing to release: receive in place
+        }
+
+        alignas(memcpy_any_unique_ptr) uint8_t buffer[sizeof(memcpy_any_unique_ptr)];
+        bool success = false;
+        if (copy_fn_dest(reinterpret_cast<memcpy_any_unique_ptr *>(buffer), src))
+        {
+            reset();
+            memcpy(static_cast<void *>(this), buffer, sizeof(memcpy_any_unique_ptr));
+            success = true;
+        }
+        return success;
+    }
+
+    // Claims a sent pointer directly from addressable storage (see memcpy_unique_ptr::memcpy_adopt).
+    void memcpy_adopt(const void *const src) noexcept
+    {
+        reset();
+        memcpy(static_cast<void *>(this), src, sizeof(memcpy_any_unique_ptr));
+    }
+
+private:
+    void *ptr = nullptr;
+    const memcpy_any_type *type = nullptr;
+};
+
+/**
+ * Factory function: auto msg = make_memcpy_any_unique_ptr<Telemetry>(args...);
+ * Same construction rules as make_memcpy_unique_ptr (an exhausted pool yields an empty pointer).
+ */
+template <typename T, typename... ParaTypes>
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_any_unique_ptr>::type
+make_memcpy_any_unique_ptr(ParaTypes &&...paras)
+{
+    return memcpy_any_unique_ptr{make_memcpy_unique_ptr<T>(std::forward<ParaTypes>(paras)...)};
+}
+
+// Two plain pointers: a bitwise move is a move.
+template <>
+struct memcpy_is_trivially_relocatable<memcpy_any_unique_ptr> : std::true_type
+{
+};
+
+static_assert(sizeof(memcpy_any_unique_ptr) == 2 * sizeof(void *), "memcpy_any_unique_ptr is a payload and a type pointer");
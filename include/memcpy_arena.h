@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "memcpy_construct.h"
+#include "memcpy_unique_pointer.h"
+
+/**
+ * Bump allocator over a caller-provided region, for messages that all die at the
+ * end of one processing cycle:
+ *
+ *     static memcpy_arena_buffer<4096> cycle_arena;
+ *     ...
+ *     auto event = make_memcpy_unique_ptr_in<Event>(cycle_arena, args...);
+ *     event.memcpy_send(...);                  // one-word pointer, same hooks as ever
+ *     ...
+ *     cycle_arena.reset();                     // end of cycle: everything reclaimed in O(1)
+ *
+ * Allocation is a compare-exchange on the offset (lock-free, callable from any
+ * task); there is no per-object free. Pointers from make_memcpy_unique_ptr_in only
+ * run the destructor of their object, and for a trivially destructible T nothing
+ * at all (memcpy_arena_unique_ptr<T> is then trivially destructible too).
+ *
+ * reset() recycles the whole region, so every message of the cycle must have been
+ * released (or at least must never be used again) by then, including the ones still
+ * parked in queues. Exhaustion is reported by an empty pointer, never by an exception.
+ */
+class memcpy_arena
+{
+public:
+    constexpr memcpy_arena(void *region, std::size_t bytes) noexcept
+        : base(static_cast<unsigned char *>(region)), capacity_bytes(bytes), offset(0)
+    {
+    }
+
+    memcpy_arena(const memcpy_arena &) = delete;
+    memcpy_arena &operator=(const memcpy_arena &) = delete;
+
+    // Returns uninitialized storage, or nullptr if the rest of the region is too small. 'alignment' is a power of two.
+    void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) noexcept
+    {
+        const uintptr_t start = reinterpret_cast<uintptr_t>(base);
+        std::size_t used = offset.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const std::size_t aligned = static_cast<std::size_t>(((start + used + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1)) - start);
+            if (aligned > capacity_bytes || capacity_bytes - aligned < bytes)
+            {
+                return nullptr; // Exhausted for this cycle
+            }
+            if (offset.compare_exchange_weak(used, aligned + bytes, std::memory_order_relaxed))
+            {
+                return base + aligned;
+            }
+        }
+    }
+
+    // Starts a new cycle: all storage handed out so far is reused. No object of the old cycle may still be in use.
+    void reset() noexcept { offset.store(0, std::memory_order_relaxed); }
+
+    std::size_t used() const noexcept { return offset.load(std::memory_order_relaxed); }
+    std::size_t capacity() const noexcept { return capacity_bytes; }
+
+private:
+    unsigned char *const base;
+    const std::size_t capacity_bytes;
+    std::atomic<std::size_t> offset;
+};
+
+// An arena with its region built in, e.g. a static per-cycle arena that never touches the heap.
+template <std::size_t Bytes>
+class memcpy_arena_buffer : public memcpy_arena
+{
+public:
+    memcpy_arena_buffer() noexcept : memcpy_arena(region, Bytes) {}
+
+private:
+    alignas(std::max_align_t) unsigned char region[Bytes];
+};
+
+// Resets 'arena' when the cycle's scope ends
+class memcpy_arena_session
+{
+public:
+    explicit memcpy_arena_session(memcpy_arena &arena) noexcept : arena(arena) {}
+    ~memcpy_arena_session() { arena.reset(); }
+
+    memcpy_arena_session(const memcpy_arena_session &) = delete;
+    memcpy_arena_session &operator=(const memcpy_arena_session &) = delete;
+
+private:
+    memcpy_arena &arena;
+};
+
+// Deleter of arena objects: the storage goes back with the next reset(), so only the destructor runs.
+template <class T>
+struct memcpy_arena_delete
+{
+    static_assert(!std::is_array<T>::value, "memcpy_arena_delete releases single objects");
+
+    void operator()(T *ptr) const noexcept { ptr->~T(); }
+};
+
+// Nothing to do for a trivially destructible T: the pointer's destructor drops away
+template <class T>
+struct memcpy_is_noop_deleter<memcpy_arena_delete<T>> : std::is_trivially_destructible<T>
+{
+};
+
+template <class T>
+using memcpy_arena_unique_ptr = memcpy_unique_ptr<T, memcpy_arena_delete<T>>;
+
+/**
+ * Factory function: auto msg = make_memcpy_unique_ptr_in<Event>(arena, args...);
+ * Same construction rules as make_memcpy_unique_ptr; an exhausted arena yields an empty pointer.
+ */
+template <typename T, typename... ParaTypes>
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_arena_unique_ptr<T>>::type
+make_memcpy_unique_ptr_in(memcpy_arena &arena, ParaTypes &&...paras)
+{
+    void *const storage = arena.allocate(sizeof(T), alignof(T));
+    if (storage == nullptr)
+    {
+        return memcpy_arena_unique_ptr<T>{};
+    }
+    return memcpy_arena_unique_ptr<T>{memcpy_construct_at<T>(storage, std::forward<ParaTypes>(paras)...)};
+}
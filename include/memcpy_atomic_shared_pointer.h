@@ -0,0 +1,231 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "memcpy_shared_pointer.h"
+
+/**
+ * Number of readers that can be inside memcpy_atomic_shared_ptr::load at the same
+ * time; further readers wait for a free slot. Each slot costs one word plus one
+ * buffered memcpy_shared_ptr per atomic pointer.
+ */
+#ifndef MEMCPY_SMART_PTR_HAZARD_SLOTS
+#define MEMCPY_SMART_PTR_HAZARD_SLOTS 4
+#endif
+
+/**
+ * A memcpy_shared_ptr slot that many tasks can read and write concurrently, e.g.
+ * the latest configuration snapshot published by one task and read by many.
+ *
+ * The value lives in one of a few internal buffers; the current one is published
+ * through an atomic pointer. A reader announces the buffer it is about to copy in
+ * a hazard slot, re-checks that it is still current and copies it (one counter
+ * increment), so readers never take a lock and never block the writer. Writers
+ * serialize on a spinlock among themselves, fill a buffer no reader can see and
+ * publish it; buffers that are still being read are left alone and released by
+ * a later write. A value is therefore released when it has been replaced and no
+ * reader holds its buffer, not necessarily during the store that replaced it, and
+ * always after the writer lock is dropped, so a free never delays other writers.
+ *
+ * The atomic pointer itself is not bitwise sendable; the pointers it hands out are.
+ * On cores without compare-exchange instructions the atomics go through libatomic.
+ *
+ * Waiting is busy-waiting, which only ends if the task being waited for can run. On
+ * a single-core RTOS this bounds who may call what: writers must share one priority
+ * (a higher-priority writer spinning on the lock of a preempted one never lets it
+ * finish), and at most MEMCPY_SMART_PTR_HAZARD_SLOTS tasks may be inside load() at a
+ * time. Readers beyond that, and interrupt handlers (with an ISR-safe Policy), use
+ * try_load(), which gives up instead of waiting for a slot.
+ */
+template <class T, class Policy = memcpy_default_lock_policy>
+class memcpy_atomic_shared_ptr
+{
+public:
+    using value_type = memcpy_shared_ptr<T, Policy>;
+
+    memcpy_atomic_shared_ptr() noexcept : current(&buffers[0]) {}
+
+    explicit memcpy_atomic_shared_ptr(value_type desired) : current(&buffers[0])
+    {
+        buffers[0] = std::move(desired);
+    }
+
+    memcpy_atomic_shared_ptr(const memcpy_atomic_shared_ptr &) = delete;
+    memcpy_atomic_shared_ptr &operator=(const memcpy_atomic_shared_ptr &) = delete;
+
+    // No reader or writer may still be running
+    ~memcpy_atomic_shared_ptr() = default;
+
+    // Returns a new owner of the current value without taking a lock.
+    value_type load() const
+    {
+        std::atomic<const value_type *> *hazard = try_claim_hazard();
+        while (hazard == nullptr)
+        {
+            hazard = try_claim_hazard(); // Every slot is taken: wait for a reader to finish
+        }
+        return read(*hazard);
+    }
+
+    // Like load(), but returns false (leaving 'out' alone) instead of waiting when every hazard slot is taken.
+    bool try_load(value_type &out) const
+    {
+        std::atomic<const value_type *> *const hazard = try_claim_hazard();
+        if (hazard == nullptr)
+        {
+            return false;
+        }
+        out = read(*hazard);
+        return true;
+    }
+
+    // Publishes 'desired' as the new value.
+    void store(value_type desired)
+    {
+        retired_values retired; // Released once 'guard' has dropped the writer lock
+        writer_guard guard{writer_lock};
+        publish(std::move(desired), retired);
+    }
+
+    // Publishes 'desired' and returns the value it replaced.
+    value_type exchange(value_type desired)
+    {
+        retired_values retired;
+        writer_guard guard{writer_lock};
+        value_type previous{*current.load(std::memory_order_relaxed)};
+        publish(std::move(desired), retired);
+        return previous;
+    }
+
+    /**
+     * Publishes 'desired' if the current value still refers to the same object as
+     * 'expected'. Otherwise 'expected' is replaced by the current value and false
+     * is returned.
+     */
+    bool compare_exchange(value_type &expected, value_type desired)
+    {
+        value_type seen; // Moved into 'expected' after the unlock, which may release the old 'expected'
+        {
+            retired_values retired;
+            writer_guard guard{writer_lock};
+            const value_type &now = *current.load(std::memory_order_relaxed);
+            if (now.get() == expected.get() && now.owner_equal(expected))
+            {
+                publish(std::move(desired), retired);
+                return true;
+            }
+            seen = now;
+        }
+        expected = std::move(seen);
+        return false;
+    }
+
+private:
+    static constexpr std::size_t hazard_count = MEMCPY_SMART_PTR_HAZARD_SLOTS;
+
+    // One buffer per reader that may hold one, one current, one to write into
+    static constexpr std::size_t buffer_count = hazard_count + 2;
+
+    class writer_guard
+    {
+    public:
+        explicit writer_guard(std::atomic_flag &lock) : lock(lock)
+        {
+            while (lock.test_and_set(std::memory_order_acquire))
+            {
+            }
+        }
+        ~writer_guard() { lock.clear(std::memory_order_release); }
+
+    private:
+        std::atomic_flag &lock;
+    };
+
+    // Claims a free hazard slot for this reader, or returns nullptr if every slot is taken
+    std::atomic<const value_type *> *try_claim_hazard() const
+    {
+        for (std::size_t i = 0; i < hazard_count; i++)
+        {
+            const value_type *expected = nullptr;
+            if (hazards[i].compare_exchange_strong(expected, &buffers[0] + buffer_count, std::memory_order_acquire))
+            {
+                return &hazards[i]; // Holds a sentinel (one past the buffers) until the first announcement
+            }
+        }
+        return nullptr;
+    }
+
+    // Copies the current value under 'hazard', then frees the slot
+    value_type read(std::atomic<const value_type *> &hazard) const
+    {
+        for (;;)
+        {
+            const value_type *seen = current.load(std::memory_order_acquire);
+            hazard.store(seen, std::memory_order_seq_cst);
+            // Once announced, a still-current buffer cannot be overwritten until the hazard is cleared
+            if (current.load(std::memory_order_seq_cst) == seen)
+            {
+                value_type snapshot{*seen};
+                hazard.store(nullptr, std::memory_order_release);
+                return snapshot;
+            }
+        }
+    }
+
+    bool is_read(const value_type *buffer) const
+    {
+        for (std::size_t i = 0; i < hazard_count; i++)
+        {
+            if (hazards[i].load(std::memory_order_seq_cst) == buffer)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Values a write takes out of the buffers, so that freeing them does not extend the writer lock
+    struct retired_values
+    {
+        value_type values[buffer_count];
+        std::size_t count = 0;
+
+        void take(value_type &buffer) { values[count++] = std::move(buffer); }
+    };
+
+    // Writer lock held: fills a buffer nobody can see, publishes it and retires stale buffers.
+    void publish(value_type &&desired, retired_values &retired)
+    {
+        value_type *const previous = current.load(std::memory_order_relaxed);
+        value_type *target = nullptr;
+        while (target == nullptr)
+        {
+            for (std::size_t i = 0; i < buffer_count && target == nullptr; i++)
+            {
+                if (&buffers[i] != previous && !is_read(&buffers[i]))
+                {
+                    target = &buffers[i];
+                }
+            }
+        }
+
+        retired.take(*target); // Whatever stale value the buffer still held
+        *target = std::move(desired);
+        current.store(target, std::memory_order_seq_cst);
+
+        for (std::size_t i = 0; i < buffer_count; i++)
+        {
+            if (&buffers[i] != target && !is_read(&buffers[i]))
+            {
+                retired.take(buffers[i]);
+            }
+        }
+    }
+
+    value_type buffers[buffer_count];
+    std::atomic<value_type *> current;
+    mutable std::atomic<const value_type *> hazards[hazard_count]{};
+    std::atomic_flag writer_lock = ATOMIC_FLAG_INIT;
+};
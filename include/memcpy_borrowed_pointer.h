@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+template <class T>
+class memcpy_borrowed_ptr;
+
+template <class T>
+struct memcpy_is_borrowed_ptr : std::false_type
+{
+};
+
+template <class T>
+struct memcpy_is_borrowed_ptr<memcpy_borrowed_ptr<T>> : std::true_type
+{
+};
+
+// True if a memcpy_borrowed_ptr<T> can borrow from an Owner: a smart pointer whose get() converts to T*
+template <class Owner, class T, class = void>
+struct memcpy_is_borrowable_from : std::false_type
+{
+};
+
+template <class Owner, class T>
+struct memcpy_is_borrowable_from<Owner, T, std::void_t<decltype(std::declval<const Owner &>().get())>>
+    : std::integral_constant<bool, !memcpy_is_borrowed_ptr<Owner>::value &&
+                                       std::is_convertible<decltype(std::declval<const Owner &>().get()), T *>::value>
+{
+};
+
+/**
+ * Non-owning view of an object managed by one of the smart pointers: for read-only
+ * helpers that only look at a message while its owner keeps it alive.
+ *
+ *     int checksum(memcpy_borrowed_ptr<const Frame> frame);
+ *     checksum(shared_frame);                                  // no count update
+ *
+ * Borrowing costs nothing: no reference is taken (unlike copying a
+ * memcpy_shared_ptr), the view is trivially copyable and constexpr-friendly, and
+ * it can be built from anything with a get() that converts to T*
+ * (memcpy_unique_ptr, memcpy_shared_ptr, memcpy_intrusive_ptr, memcpy_box, ...) or from
+ * a raw pointer. Borrowing from a temporary owner does not compile, since the
+ * object would be gone before the view is used. The view must not outlive its owner,
+ * and a borrowed pointer is never a substitute for sending the owner itself.
+ */
+template <class T>
+class memcpy_borrowed_ptr
+{
+    template <class Owner>
+    static constexpr bool is_owner = memcpy_is_borrowable_from<std::remove_cv_t<std::remove_reference_t<Owner>>, T>::value;
+
+public:
+    using element_type = T;
+
+    constexpr memcpy_borrowed_ptr() noexcept = default;
+    constexpr memcpy_borrowed_ptr(std::nullptr_t) noexcept {}
+    constexpr memcpy_borrowed_ptr(T *ptr) noexcept : ptr(ptr) {}
+
+    // Borrows the object of a smart pointer, which keeps ownership
+    template <class Owner, typename std::enable_if<is_owner<Owner>, int>::type = 0>
+    constexpr memcpy_borrowed_ptr(const Owner &owner) noexcept : ptr(owner.get()) {}
+
+    // A temporary owner would release the object at the end of the full expression
+    template <class Owner, typename std::enable_if<!std::is_lvalue_reference<Owner>::value && is_owner<Owner>, int>::type = 0>
+    memcpy_borrowed_ptr(Owner &&owner) = delete;
+
+    // Derived-to-base and to-const conversions, as for raw pointers
+    template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+    constexpr memcpy_borrowed_ptr(const memcpy_borrowed_ptr<U> &other) noexcept : ptr(other.get()) {}
+
+    constexpr T *get() const noexcept { return ptr; }
+    constexpr T *operator->() const noexcept { return ptr; }
+    constexpr T &operator*() const noexcept { return *ptr; }
+
+    constexpr explicit operator bool() const noexcept { return ptr != nullptr; }
+
+    friend constexpr bool operator==(memcpy_borrowed_ptr a, memcpy_borrowed_ptr b) noexcept { return a.ptr == b.ptr; }
+    friend constexpr bool operator!=(memcpy_borrowed_ptr a, memcpy_borrowed_ptr b) noexcept { return a.ptr != b.ptr; }
+
+private:
+    T *ptr = nullptr;
+};
+
+// Borrows 'owner's object with its deduced type: auto view = memcpy_borrow(frame);
+template <class Owner>
+constexpr auto memcpy_borrow(const Owner &owner) noexcept
+{
+    return memcpy_borrowed_ptr<std::remove_pointer_t<decltype(owner.get())>>{owner};
+}
+
+template <class Owner, typename std::enable_if<!std::is_lvalue_reference<Owner>::value, int>::type = 0>
+void memcpy_borrow(Owner &&owner) = delete;
+
+static_assert(std::is_trivially_copyable<memcpy_borrowed_ptr<int>>::value, "memcpy_borrowed_ptr is plain data");
+static_assert(sizeof(memcpy_borrowed_ptr<int>) == sizeof(int *), "memcpy_borrowed_ptr is one pointer");
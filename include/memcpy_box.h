@@ -0,0 +1,218 @@
+#pragma once
+
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // For memcpy
+#include <new>     // For placement new and std::launder
+#include <utility>
+
+#include "memcpy_construct.h"
+#include "memcpy_relocate.h"
+
+// True if memcpy_box<T, InlineBytes> keeps its T inline instead of on the heap
+template <class T, std::size_t InlineBytes>
+struct memcpy_box_is_inline
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value && sizeof(T) <= InlineBytes>
+{
+};
+
+/**
+ * Storage of a memcpy_box. A small trivially copyable T lives in the box itself,
+ * so sending it is a plain bitwise copy of the value; anything else is a pointer
+ * to a heap object, as in memcpy_unique_ptr.
+ */
+template <class T, bool Inline>
+class memcpy_box_storage
+{
+protected:
+    T *object() noexcept { return engaged ? std::launder(reinterpret_cast<T *>(bytes)) : nullptr; }
+    const T *object() const noexcept { return engaged ? std::launder(reinterpret_cast<const T *>(bytes)) : nullptr; }
+
+    template <typename... ParaTypes>
+    void construct(ParaTypes &&...paras)
+    {
+        memcpy_construct_at<T>(bytes, std::forward<ParaTypes>(paras)...);
+        engaged = true;
+    }
+
+    // Trivially copyable, hence trivially destructible: nothing to run
+    void destroy() noexcept { engaged = false; }
+
+    // The bits now live elsewhere (memcpy_send)
+    void disengage() noexcept { engaged = false; }
+
+private:
+    alignas(T) unsigned char bytes[sizeof(T)];
+    bool engaged = false;
+};
+
+template <class T>
+class memcpy_box_storage<T, false>
+{
+protected:
+    T *object() noexcept { return ptr; }
+    const T *object() const noexcept { return ptr; }
+
+    template <typename... ParaTypes>
+    void construct(ParaTypes &&...paras)
+    {
+        ptr = memcpy_new<T>(std::forward<ParaTypes>(paras)...);
+    }
+
+    void destroy() noexcept
+    {
+        delete ptr;
+        ptr = nullptr;
+    }
+
+    void disengage() noexcept { ptr = nullptr; }
+
+private:
+    T *ptr = nullptr;
+};
+
+/**
+ * A unique-ownership box with small-object storage, for queue messages that are too
+ * small to be worth an allocation (status codes, timestamps, ...).
+ *
+ * A trivially copyable T of at most InlineBytes is stored inline and never touches
+ * the allocator; a larger (or non-trivially copyable) T is allocated on the heap.
+ * Either way the box is moved through C-style buffers with the same memcpy_send /
+ * memcpy_receive hooks and ownership rules as memcpy_unique_ptr. Note that an inline
+ * box is sizeof(T) plus a flag wide, so the queue item size follows T.
+ */
+template <class T, std::size_t InlineBytes = 16>
+class memcpy_box : private memcpy_box_storage<T, memcpy_box_is_inline<T, InlineBytes>::value>
+{
+public:
+    static constexpr bool is_inline = memcpy_box_is_inline<T, InlineBytes>::value;
+
+    // Creates an empty box
+    memcpy_box() noexcept = default;
+
+    // Constructs the value in the box (or on the heap above the inline threshold)
+    template <typename... ParaTypes>
+    explicit memcpy_box(std::in_place_t, ParaTypes &&...paras)
+    {
+        this->construct(std::forward<ParaTypes>(paras)...);
+    }
+
+    // --- Ownership Rules ---
+    memcpy_box(const memcpy_box &obj) = delete;
+    memcpy_box &operator=(const memcpy_box &obj) = delete;
+
+    // Move: a bitwise transfer, the dying box is left empty
+    memcpy_box(memcpy_box &&dyingObj) noexcept
+    {
+        memcpy(static_cast<void *>(this), static_cast<const void *>(&dyingObj), sizeof(memcpy_box));
+        dyingObj.disengage();
+    }
+
+    memcpy_box &operator=(memcpy_box &&dyingObj) noexcept
+    {
+        if (this != &dyingObj)
+        {
+            reset();
+            memcpy(static_cast<void *>(this), static_cast<const void *>(&dyingObj), sizeof(memcpy_box));
+            dyingObj.disengage();
+        }
+        return *this;
+    }
+
+    ~memcpy_box() { reset(); }
+
+    // --- Accessors ---
+    T *get() noexcept { return this->object(); }
+    const T *get() const noexcept { return this->object(); }
+    T *operator->() noexcept { return get(); }
+    T &operator*() noexcept { return *get(); }
+
+    explicit operator bool() const noexcept { return get() != nullptr; }
+
+    // Destroys the value (and frees it if it was on the heap)
+    void reset() noexcept
+    {
+        if (get() != nullptr)
+        {
+            this->destroy();
+        }
+    }
+
+    // --- C-API Bridge Interface (SFINAE Guarded) ---
+
+    // Signature Requirement: bool func(void* dest, const memcpy_box* src)
+    template <typename _Function>
+    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_box *const>;
+
+    // Signature Requirement: bool func(memcpy_box* dest, const void* src)
+    template <typename _Function>
+    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_box *const, const void *const>;
+
+    /**
+     * Prepares the box for a bitwise send (e.g., xQueueSend).
+     * If the copy function succeeds the value (or the heap object) now belongs to the
+     * bits in 'dest' and this box is left empty.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_send_signature<_Function>, bool>::type
+    memcpy_send(void *const dest, _Function copy_fn_src)
+    {
+        bool success = false;
+        if (copy_fn_src(dest, this))
+        {
+            this->disengage();
+            success = true;
+        }
+        return success;
+    }
+
+    /**
+     * Claims ownership from a bitwise source (e.g., xQueueReceive).
+     * An empty box is written in place; otherwise the bits land in a temporary buffer
+     * before the current value is released. On failure the copy function must not write.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type
+    memcpy_receive(const void *const src, _Function copy_fn_dest)
+    {
+        if (get() == nullptr)
+        {
+            return copy_fn_dest(this, src); // Nothing to release: receive in place
+        }
+
+        alignas(memcpy_box) uint8_t buffer[sizeof(memcpy_box)];
+        bool success = false;
+        if (copy_fn_dest(reinterpret_cast<memcpy_box *>(buffer), src))
+        {
+            reset();
+            memcpy(static_cast<void *>(this), buffer, sizeof(memcpy_box));
+            success = true;
+        }
+        return success;
+    }
+
+    // Claims a sent box directly from addressable storage (see memcpy_unique_ptr::memcpy_adopt).
+    void memcpy_adopt(const void *const src) noexcept
+    {
+        reset();
+        memcpy(static_cast<void *>(this), src, sizeof(memcpy_box));
+    }
+};
+
+/**
+ * Factory function: auto status = make_memcpy_box<Status>(args...);
+ * Allocates only when T does not fit inline.
+ */
+template <typename T, std::size_t InlineBytes = 16, typename... ParaTypes>
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_box<T, InlineBytes>>::type
+make_memcpy_box(ParaTypes &&...paras)
+{
+    return memcpy_box<T, InlineBytes>{std::in_place, std::forward<ParaTypes>(paras)...};
+}
+
+// Inline values are trivially copyable and heap values sit behind a plain pointer.
+template <class T, std::size_t InlineBytes>
+struct memcpy_is_trivially_relocatable<memcpy_box<T, InlineBytes>> : std::true_type
+{
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <type_traits>
+#include <new> // For placement new
+#include <utility>
+
+/**
+ * Construction helpers shared by the factories (make_memcpy_unique_ptr,
+ * make_memcpy_shared_ptr, ...). Arguments are forwarded straight to the final
+ * storage, so a large object is built in its heap slot without a temporary.
+ * Types without a matching constructor fall back to brace initialization, which
+ * lets aggregates (plain message structs) be created from their member values.
+ */
+
+template <class T, typename = void, class... ParaTypes>
+struct memcpy_is_brace_constructible_impl : std::false_type
+{
+};
+
+template <class T, class... ParaTypes>
+struct memcpy_is_brace_constructible_impl<T, std::void_t<decltype(T{std::declval<ParaTypes>()...})>, ParaTypes...>
+    : std::true_type
+{
+};
+
+// True if the factories can build a T from the arguments: T(args...) or, failing that, T{args...}.
+template <class T, class... ParaTypes>
+struct memcpy_is_constructible
+    : std::integral_constant<bool, !std::is_array<T>::value &&
+                                       (std::is_constructible<T, ParaTypes...>::value ||
+                                        memcpy_is_brace_constructible_impl<T, void, ParaTypes...>::value)>
+{
+};
+
+// Tag selecting default-initialization (no zeroing of trivial members), see the *_for_overwrite factories.
+struct memcpy_for_overwrite_t
+{
+    explicit memcpy_for_overwrite_t() = default;
+};
+
+inline constexpr memcpy_for_overwrite_t memcpy_for_overwrite{};
+
+// Constructs a T in 'storage' from the arguments, T(args...) preferred over T{args...}.
+template <class T, class... ParaTypes>
+T *memcpy_construct_at(void *storage, ParaTypes &&...paras)
+{
+    if constexpr (std::is_constructible<T, ParaTypes...>::value)
+    {
+        return ::new (storage) T(std::forward<ParaTypes>(paras)...);
+    }
+    else
+    {
+        return ::new (storage) T{std::forward<ParaTypes>(paras)...};
+    }
+}
+
+// Same with a new-expression, so a class-specific operator new (e.g. a pool) is honoured.
+template <class T, class... ParaTypes>
+T *memcpy_new(ParaTypes &&...paras)
+{
+    if constexpr (std::is_constructible<T, ParaTypes...>::value)
+    {
+        return new T(std::forward<ParaTypes>(paras)...);
+    }
+    else
+    {
+        return new T{std::forward<ParaTypes>(paras)...};
+    }
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // For memcpy
+#include <utility>
+
+#include "memcpy_construct.h"
+#include "memcpy_lock_policy.h"
+#include "memcpy_relocate.h"
+
+/**
+ * CRTP base that embeds the reference count in the object itself:
+ *
+ *     struct Frame : memcpy_intrusive_ref_counted<Frame> { ... };
+ *
+ * It provides the ADL hooks memcpy_intrusive_ptr looks for. A type that cannot
+ * derive from it may declare the three hooks itself, in its own namespace:
+ *
+ *     void memcpy_intrusive_add_ref(const Frame *);
+ *     void memcpy_intrusive_release(const Frame *);    // deletes on the last reference
+ *     memcpy_ref_count_t memcpy_intrusive_use_count(const Frame *);
+ *
+ * Policy selects how the count is updated (see memcpy_lock_policy.h). The object
+ * is released with delete, so class-specific operator delete (e.g. a pool) applies.
+ */
+template <class Derived, class Policy = memcpy_default_lock_policy>
+class memcpy_intrusive_ref_counted
+{
+public:
+    using counter_policy = Policy;
+
+protected:
+    memcpy_intrusive_ref_counted() noexcept = default;
+
+    // A copy of the object is a new object without owners
+    memcpy_intrusive_ref_counted(const memcpy_intrusive_ref_counted &) noexcept {}
+    memcpy_intrusive_ref_counted &operator=(const memcpy_intrusive_ref_counted &) noexcept { return *this; }
+
+    ~memcpy_intrusive_ref_counted() = default;
+
+private:
+    mutable memcpy_shared_ptr_counter use_count{0};
+
+    friend void memcpy_intrusive_add_ref(const Derived *object) noexcept
+    {
+        Policy::increment(object->use_count);
+    }
+
+    friend void memcpy_intrusive_release(const Derived *object) noexcept
+    {
+        if (Policy::decrement(object->use_count) == 1)
+        {
+            delete object;
+        }
+    }
+
+    friend memcpy_ref_count_t memcpy_intrusive_use_count(const Derived *object) noexcept
+    {
+        return Policy::get_count(object->use_count);
+    }
+};
+
+/**
+ * A shared pointer whose count lives in the managed object (see memcpy_intrusive_ref_counted).
+ * It is one pointer wide, so a queue item is half the size of a memcpy_shared_ptr and
+ * reaching the count does not touch a separate control block. memcpy_send and
+ * memcpy_receive follow the same reference-count contract as memcpy_shared_ptr.
+ */
+template <class T>
+class memcpy_intrusive_ptr
+{
+public:
+    memcpy_intrusive_ptr() noexcept : ptr(nullptr) {}
+
+    // Takes a new reference on 'ptr' (a fresh object starts without owners)
+    memcpy_intrusive_ptr(T *ptr) : ptr(ptr)
+    {
+        acquire();
+    }
+
+    // Copy logic
+    memcpy_intrusive_ptr(const memcpy_intrusive_ptr &obj) : ptr(obj.ptr)
+    {
+        acquire();
+    }
+
+    memcpy_intrusive_ptr &operator=(const memcpy_intrusive_ptr &obj)
+    {
+        if (ptr != obj.ptr)
+        {
+            T *const old = ptr;
+            ptr = obj.ptr;
+            acquire();
+            if (old != nullptr)
+            {
+                memcpy_intrusive_release(old);
+            }
+        }
+        return *this;
+    }
+
+    // Move logic
+    memcpy_intrusive_ptr(memcpy_intrusive_ptr &&dyingObj) noexcept : ptr(dyingObj.ptr)
+    {
+        dyingObj.ptr = nullptr;
+    }
+
+    memcpy_intrusive_ptr &operator=(memcpy_intrusive_ptr &&obj) noexcept
+    {
+        if (this != &obj)
+        {
+            __cleanup__();
+            ptr = obj.ptr;
+            obj.ptr = nullptr;
+        }
+        return *this;
+    }
+
+    ~memcpy_intrusive_ptr() { __cleanup__(); }
+
+    // Accessors
+    memcpy_ref_count_t get_count() const { return ptr == nullptr ? 0 : memcpy_intrusive_use_count(ptr); }
+    T *get() const { return this->ptr; }
+    T *operator->() const { return this->ptr; }
+    T &operator*() const { return *this->ptr; }
+
+    explicit operator bool() const noexcept { return ptr != nullptr; }
+
+    void reset() { __cleanup__(); }
+
+    // SFINAE checks for C-API compatibility
+    template <typename _Function>
+    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_intrusive_ptr *const>;
+
+    template <typename _Function>
+    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_intrusive_ptr *const, const void *const>;
+
+    /**
+     * Bridges C++ ownership to C-style Send.
+     * Increments the count because the bitwise copy in 'dest' becomes a new 'owner'.
+     * The owner is registered before the copy: once the bits are in the queue a
+     * receiver may take them and drop its reference right away.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_send_signature<_Function>, bool>::type memcpy_send(void *const dest, _Function copy_fn)
+    {
+        acquire(); // Register the new bitwise owner
+        if (!copy_fn(dest, this))
+        {
+            if (ptr != nullptr)
+            {
+                memcpy_intrusive_release(ptr); // Not sent after all; this owner remains, so nothing is freed
+            }
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Bridges C-style Receive to C++ ownership.
+     * Releases the current reference before taking over the bitwise-received one;
+     * an empty pointer is written in place. On failure the copy function must not write.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type memcpy_receive(const void *const src, _Function copy_fn)
+    {
+        if (nullptr == ptr)
+        {
+            return copy_fn(this, src); // Nothing to release: receive in place
+        }
+
+        uint8_t buffer[sizeof(memcpy_intrusive_ptr)];
+        bool success = false;
+        if (copy_fn(reinterpret_cast<memcpy_intrusive_ptr *>(buffer), src))
+        {
+            __cleanup__(); // Relinquish current reference
+            memcpy(static_cast<void *>(this), buffer, sizeof(memcpy_intrusive_ptr));
+            success = true;
+        }
+        return success;
+    }
+
+    // Claims a sent pointer directly from addressable storage (see memcpy_shared_ptr::memcpy_adopt).
+    void memcpy_adopt(const void *const src) noexcept
+    {
+        __cleanup__();
+        memcpy(static_cast<void *>(this), src, sizeof(memcpy_intrusive_ptr));
+    }
+
+private:
+    T *ptr;
+
+    void acquire()
+    {
+        if (ptr != nullptr)
+        {
+            memcpy_intrusive_add_ref(ptr);
+        }
+    }
+
+    // Internal cleanup: Releases this owner's reference; the last one deletes the object.
+    void __cleanup__()
+    {
+        if (ptr != nullptr)
+        {
+            memcpy_intrusive_release(ptr);
+            ptr = nullptr;
+        }
+    }
+};
+
+/**
+ * Helper function to create a memcpy_intrusive_ptr with a new object.
+ * For a T derived from memcpy_pool_allocated an exhausted pool yields an empty pointer.
+ */
+template <typename T, typename... ParaTypes>
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_intrusive_ptr<T>>::type
+make_memcpy_intrusive_ptr(ParaTypes &&...paras)
+{
+    return memcpy_intrusive_ptr<T>{memcpy_new<T>(std::forward<ParaTypes>(paras)...)};
+}
+
+// A bare pointer: relocating it moves the reference with it.
+template <class T>
+struct memcpy_is_trivially_relocatable<memcpy_intrusive_ptr<T>> : std::true_type
+{
+};
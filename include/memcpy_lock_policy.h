@@ -0,0 +1,219 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Portable reference-count policies for memcpy_shared_ptr.
+ *
+ * Only standard headers are used, so the library builds with libstdc++, libc++
+ * and the Arm/IAR toolchains alike. A policy is a stateless class with static
+ * increment / decrement / increment_if_nonzero / get_count operations on a
+ * memcpy_shared_ptr_counter.
+ * All policies share that counter layout, which is what lets a control block be
+ * handed from one policy to another (see memcpy_shared_ptr::convert_lock_policy).
+ */
+
+/**
+ * Width of the reference counter. Defaults to 32 bits; define it as uint16_t or
+ * uint8_t to shrink control blocks on small MCUs. The counter is not checked for
+ * overflow, so it must be wide enough for the most owners an object can have
+ * (bitwise copies parked in queue buffers included).
+ */
+#ifndef MEMCPY_SMART_PTR_COUNT_TYPE
+#define MEMCPY_SMART_PTR_COUNT_TYPE uint32_t
+#endif
+
+using memcpy_ref_count_t = MEMCPY_SMART_PTR_COUNT_TYPE;
+
+static_assert(std::is_unsigned<memcpy_ref_count_t>::value, "MEMCPY_SMART_PTR_COUNT_TYPE must be an unsigned integer type");
+
+using memcpy_shared_ptr_counter = std::atomic<memcpy_ref_count_t>;
+
+/**
+ * Critical-section hooks used by memcpy_lock_policy_critical_section.
+ *
+ * Define both macros to plug in the RTOS, e.g. for FreeRTOS:
+ *     #define MEMCPY_SMART_PTR_ENTER_CRITICAL() taskENTER_CRITICAL_FROM_ISR()
+ *     #define MEMCPY_SMART_PTR_EXIT_CRITICAL(state) taskEXIT_CRITICAL_FROM_ISR(state)
+ * ENTER returns a state value that is handed back to EXIT. Without them, GCC/Clang
+ * Cortex-M builds mask interrupts through PRIMASK and hosted builds fall back to a
+ * spinlock; other bare-metal compilers (e.g. IAR) must define the hooks.
+ *
+ * Masking interrupts only excludes the current core. On multi-core parts such as
+ * the RP2040 the hooks must also take a lock shared by the cores.
+ */
+#if defined(MEMCPY_SMART_PTR_ENTER_CRITICAL) != defined(MEMCPY_SMART_PTR_EXIT_CRITICAL)
+#error "Define both MEMCPY_SMART_PTR_ENTER_CRITICAL and MEMCPY_SMART_PTR_EXIT_CRITICAL, or neither"
+#endif
+
+#if !defined(MEMCPY_SMART_PTR_ENTER_CRITICAL) && defined(__GNUC__) && defined(__ARM_ARCH_PROFILE) && (__ARM_ARCH_PROFILE == 'M')
+#define MEMCPY_SMART_PTR_PRIMASK_CRITICAL 1
+#endif
+
+class memcpy_critical_section
+{
+public:
+    memcpy_critical_section() noexcept : state(enter()) {}
+    ~memcpy_critical_section() { exit(state); }
+
+    memcpy_critical_section(const memcpy_critical_section &) = delete;
+    memcpy_critical_section &operator=(const memcpy_critical_section &) = delete;
+
+private:
+#if defined(MEMCPY_SMART_PTR_ENTER_CRITICAL)
+    using state_type = decltype(MEMCPY_SMART_PTR_ENTER_CRITICAL());
+
+    static state_type enter() noexcept { return MEMCPY_SMART_PTR_ENTER_CRITICAL(); }
+    static void exit(state_type saved) noexcept { MEMCPY_SMART_PTR_EXIT_CRITICAL(saved); }
+#elif defined(MEMCPY_SMART_PTR_PRIMASK_CRITICAL)
+    using state_type = uint32_t;
+
+    static state_type enter() noexcept
+    {
+        uint32_t primask;
+        __asm volatile("mrs %0, primask\n\tcpsid i" : "=r"(primask)::"memory");
+        return primask;
+    }
+
+    static void exit(state_type saved) noexcept { __asm volatile("msr primask, %0" ::"r"(saved) : "memory"); }
+#else
+    using state_type = bool;
+
+    static std::atomic_flag &lock() noexcept
+    {
+        static std::atomic_flag flag = ATOMIC_FLAG_INIT;
+        return flag;
+    }
+
+    static state_type enter() noexcept
+    {
+        while (lock().test_and_set(std::memory_order_acquire))
+        {
+        }
+        return true;
+    }
+
+    static void exit(state_type) noexcept { lock().clear(std::memory_order_release); }
+#endif
+
+    state_type state;
+};
+
+// Single-threaded: plain loads and stores, no atomic read-modify-write.
+struct memcpy_lock_policy_single
+{
+    // Safe to use from an interrupt handler that shares the counter with task code
+    static constexpr bool isr_safe = false;
+
+    static void increment(memcpy_shared_ptr_counter &count, memcpy_ref_count_t n = 1)
+    {
+        count.store(static_cast<memcpy_ref_count_t>(count.load(std::memory_order_relaxed) + n), std::memory_order_relaxed);
+    }
+
+    // Returns the count before the decrement; n means the caller held the last references.
+    static memcpy_ref_count_t decrement(memcpy_shared_ptr_counter &count, memcpy_ref_count_t n = 1)
+    {
+        memcpy_ref_count_t previous = count.load(std::memory_order_relaxed);
+        count.store(static_cast<memcpy_ref_count_t>(previous - n), std::memory_order_relaxed);
+        return previous;
+    }
+
+    // Takes one reference unless the count already dropped to zero (memcpy_weak_ptr::lock).
+    static bool increment_if_nonzero(memcpy_shared_ptr_counter &count)
+    {
+        memcpy_ref_count_t current = count.load(std::memory_order_relaxed);
+        if (current == 0)
+        {
+            return false;
+        }
+        count.store(static_cast<memcpy_ref_count_t>(current + 1), std::memory_order_relaxed);
+        return true;
+    }
+
+    static memcpy_ref_count_t get_count(const memcpy_shared_ptr_counter &count) { return count.load(std::memory_order_relaxed); }
+};
+
+// Multi-threaded: std::atomic read-modify-write (LDREX/STREX, LDADD, LOCK XADD, ...).
+struct memcpy_lock_policy_atomic
+{
+    // Without native atomics the operations may go through libatomic locks
+    static constexpr bool isr_safe = memcpy_shared_ptr_counter::is_always_lock_free;
+
+    // A new owner can only be made from an existing one, so no ordering is needed here.
+    static void increment(memcpy_shared_ptr_counter &count, memcpy_ref_count_t n = 1)
+    {
+        count.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the count before the decrement; n means the caller held the last references.
+     * acq_rel makes every other owner's writes to the object visible to the one that deletes it.
+     */
+    static memcpy_ref_count_t decrement(memcpy_shared_ptr_counter &count, memcpy_ref_count_t n = 1)
+    {
+        return count.fetch_sub(n, std::memory_order_acq_rel);
+    }
+
+    // Lock-free: a compare-exchange loop that never resurrects a count that reached zero.
+    static bool increment_if_nonzero(memcpy_shared_ptr_counter &count)
+    {
+        memcpy_ref_count_t current = count.load(std::memory_order_relaxed);
+        while (current != 0)
+        {
+            if (count.compare_exchange_weak(current, static_cast<memcpy_ref_count_t>(current + 1),
+                                            std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static memcpy_ref_count_t get_count(const memcpy_shared_ptr_counter &count) { return count.load(std::memory_order_relaxed); }
+};
+
+/**
+ * Cores without atomic read-modify-write instructions (Cortex-M0/M0+): the update
+ * runs with interrupts masked, so tasks and ISRs on the same core can share pointers
+ * without going through libatomic.
+ */
+struct memcpy_lock_policy_critical_section
+{
+    static constexpr bool isr_safe = true;
+
+    static void increment(memcpy_shared_ptr_counter &count, memcpy_ref_count_t n = 1)
+    {
+        memcpy_critical_section guard;
+        memcpy_lock_policy_single::increment(count, n);
+    }
+
+    // Returns the count before the decrement; n means the caller held the last references.
+    static memcpy_ref_count_t decrement(memcpy_shared_ptr_counter &count, memcpy_ref_count_t n = 1)
+    {
+        memcpy_critical_section guard;
+        return memcpy_lock_policy_single::decrement(count, n);
+    }
+
+    static bool increment_if_nonzero(memcpy_shared_ptr_counter &count)
+    {
+        memcpy_critical_section guard;
+        return memcpy_lock_policy_single::increment_if_nonzero(count);
+    }
+
+    static memcpy_ref_count_t get_count(const memcpy_shared_ptr_counter &count) { return count.load(std::memory_order_relaxed); }
+};
+
+/**
+ * Policy used by memcpy_shared_ptr<T> when none is given. Override it with
+ * MEMCPY_SMART_PTR_DEFAULT_LOCK_POLICY; otherwise ARMv6-M (no LDREX/STREX) uses
+ * the critical-section policy and everything else uses std::atomic.
+ */
+#if defined(MEMCPY_SMART_PTR_DEFAULT_LOCK_POLICY)
+using memcpy_default_lock_policy = MEMCPY_SMART_PTR_DEFAULT_LOCK_POLICY;
+#elif defined(__ARM_ARCH_6M__)
+using memcpy_default_lock_policy = memcpy_lock_policy_critical_section;
+#else
+using memcpy_default_lock_policy = memcpy_lock_policy_atomic;
+#endif
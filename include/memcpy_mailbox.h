@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include "memcpy_atomic_shared_pointer.h"
+
+/**
+ * Single-slot, latest-value mailbox for memcpy_shared_ptr<T>: each publish
+ * overwrites the previous sample, and consumers only ever see the newest one.
+ *
+ *     memcpy_shared_mailbox<Sample> latest;
+ *     latest.publish(make_memcpy_shared_ptr<Sample>(reading));   // producer
+ *
+ *     uint32_t seen = 0;                                         // consumer
+ *     memcpy_shared_ptr<Sample> sample;
+ *     if (latest.take_newer(sample, seen)) ...
+ *
+ * Unlike a queue, stale samples are never drained one by one: a publish displaces
+ * at most the value it replaces, and frees it after the writer lock is dropped
+ * (or returns it from exchange, so a low-priority task can release it). Readers
+ * never take a lock, so a high-priority reader is never held up by a preempted
+ * publisher. take_newer checks a sequence number before touching the slot, so
+ * polling an unchanged mailbox costs one atomic load and no count traffic.
+ *
+ * The mailbox has no blocking wait of its own: pair it with the RTOS's task
+ * notification or semaphore, signalled after publish, and call take_newer when woken.
+ * Publishers serialize on a spinlock; on a single core give them the same priority
+ * (or use one publisher per mailbox).
+ */
+template <class T, class Policy = memcpy_default_lock_policy>
+class memcpy_shared_mailbox
+{
+public:
+    using value_type = memcpy_shared_ptr<T, Policy>;
+
+    memcpy_shared_mailbox() noexcept = default;
+
+    memcpy_shared_mailbox(const memcpy_shared_mailbox &) = delete;
+    memcpy_shared_mailbox &operator=(const memcpy_shared_mailbox &) = delete;
+
+    // Replaces the current sample with 'sample'
+    void publish(value_type sample)
+    {
+        slot.store(std::move(sample));
+        published.fetch_add(1, std::memory_order_release);
+    }
+
+    // Replaces the current sample and hands the displaced one back to the caller
+    value_type exchange(value_type sample)
+    {
+        value_type displaced = slot.exchange(std::move(sample));
+        published.fetch_add(1, std::memory_order_release);
+        return displaced;
+    }
+
+    // A new owner of the newest sample (empty if nothing was published yet)
+    value_type latest() const { return slot.load(); }
+
+    /**
+     * Takes the newest sample into 'out' if something was published since 'seen',
+     * which is updated; returns false (leaving 'out' alone) otherwise. Start with
+     * seen = 0. A sample published twice in quick succession may be seen once.
+     */
+    bool take_newer(value_type &out, uint32_t &seen) const
+    {
+        const uint32_t now = published.load(std::memory_order_acquire);
+        if (now == seen)
+        {
+            return false;
+        }
+        out = slot.load(); // At least as new as 'now'
+        seen = now;
+        return true;
+    }
+
+    // Number of publishes so far (wraps around)
+    uint32_t sequence() const noexcept { return published.load(std::memory_order_acquire); }
+
+private:
+    memcpy_atomic_shared_ptr<T, Policy> slot;
+    std::atomic<uint32_t> published{0};
+};
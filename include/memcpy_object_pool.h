@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Fixed-capacity object pool with O(1) allocate and deallocate.
+ *
+ * Storage for N objects of type T is reserved inside the pool itself, so a pool
+ * with static storage duration never touches the heap. Free slots are kept on a
+ * lock-free stack of slot indices; the head carries a tag that is bumped on every
+ * update to rule out ABA. On cores without atomic read-modify-write instructions
+ * (e.g. Cortex-M0+) the compare-exchange falls back to libatomic.
+ *
+ * Exhaustion is reported by allocate() returning nullptr, never by an exception.
+ */
+template <class T, std::size_t N>
+class memcpy_object_pool
+{
+    static_assert(N > 0, "memcpy_object_pool needs at least one slot");
+    static_assert(N < 0xFFFF, "memcpy_object_pool supports at most 65534 slots");
+
+public:
+    // Constant-initialized: a static pool is ready before any constructor runs.
+    constexpr memcpy_object_pool() noexcept : free_head(empty_index), unused(0), next{}, slots{} {}
+
+    memcpy_object_pool(const memcpy_object_pool &) = delete;
+    memcpy_object_pool &operator=(const memcpy_object_pool &) = delete;
+
+    /**
+     * Returns uninitialized storage for one T, or nullptr if every slot is in use.
+     * Recycled slots are preferred; slots that were never handed out are taken last.
+     */
+    void *allocate() noexcept
+    {
+        uint32_t head = free_head.load(std::memory_order_acquire);
+        while (index_of(head) != empty_index)
+        {
+            uint16_t next_index = next[index_of(head)].load(std::memory_order_relaxed);
+            if (free_head.compare_exchange_weak(head, pack(next_index, tag_of(head) + 1),
+                                                std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return slots[index_of(head)];
+            }
+        }
+
+        uint16_t fresh = unused.load(std::memory_order_relaxed);
+        while (fresh < N)
+        {
+            if (unused.compare_exchange_weak(fresh, fresh + 1, std::memory_order_relaxed))
+            {
+                return slots[fresh];
+            }
+        }
+        return nullptr; // Pool exhausted
+    }
+
+    // Returns a slot obtained from allocate(). The object in it must already be destroyed.
+    void deallocate(void *p) noexcept
+    {
+        if (p == nullptr)
+        {
+            return;
+        }
+        uint16_t index = static_cast<uint16_t>((static_cast<unsigned char *>(p) - slots[0]) / sizeof(T));
+        uint32_t head = free_head.load(std::memory_order_relaxed);
+        do
+        {
+            next[index].store(index_of(head), std::memory_order_relaxed);
+        } while (!free_head.compare_exchange_weak(head, pack(index, tag_of(head) + 1),
+                                                  std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // True if p points at one of this pool's slots
+    bool owns(const void *p) const noexcept
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(p);
+        return bytes >= slots[0] && bytes < slots[0] + sizeof(slots);
+    }
+
+    static constexpr std::size_t capacity() noexcept { return N; }
+
+private:
+    static constexpr uint16_t empty_index = 0xFFFF;
+
+    static constexpr uint16_t index_of(uint32_t head) noexcept { return static_cast<uint16_t>(head & 0xFFFFu); }
+    static constexpr uint16_t tag_of(uint32_t head) noexcept { return static_cast<uint16_t>(head >> 16); }
+    static constexpr uint32_t pack(uint16_t index, uint16_t tag) noexcept
+    {
+        return (static_cast<uint32_t>(tag) << 16) | index;
+    }
+
+    std::atomic<uint32_t> free_head; // tag:16 | index:16 of the first recycled slot
+    std::atomic<uint16_t> unused;    // slots [unused, N) have never been handed out
+    std::atomic<uint16_t> next[N];   // free-list links, kept outside the slots
+    alignas(T) unsigned char slots[N][sizeof(T)];
+};
+
+/**
+ * Opt-in mixin that routes every allocation of Derived through a static pool of N slots.
+ *
+ *     struct SensorFrame : memcpy_pool_allocated<SensorFrame, 16> { ... };
+ *
+ * make_memcpy_unique_ptr<SensorFrame>(...) then takes a slot from the pool and the
+ * pointer's destructor returns it. make_memcpy_shared_ptr<SensorFrame>(...) uses a
+ * companion pool of N fused control blocks. When the pool is exhausted the factory
+ * returns an empty pointer instead of throwing.
+ */
+template <class Derived, std::size_t N>
+class memcpy_pool_allocated
+{
+public:
+    static constexpr std::size_t memcpy_pool_capacity = N;
+
+    // Non-throwing: a new-expression yields nullptr (and constructs nothing) on exhaustion.
+    static void *operator new(std::size_t size) noexcept
+    {
+        return size == sizeof(Derived) ? pool().allocate() : nullptr;
+    }
+
+    static void operator delete(void *p) noexcept { pool().deallocate(p); }
+
+    static memcpy_object_pool<Derived, N> &pool() noexcept
+    {
+        static memcpy_object_pool<Derived, N> instance;
+        return instance;
+    }
+};
+
+// True for types that opted into pool allocation through memcpy_pool_allocated
+template <class T, typename = void>
+struct memcpy_is_pool_allocated : std::false_type
+{
+};
+
+template <class T>
+struct memcpy_is_pool_allocated<T, std::void_t<decltype(T::memcpy_pool_capacity)>> : std::true_type
+{
+};
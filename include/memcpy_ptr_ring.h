@@ -0,0 +1,242 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring> // For memcpy
+
+/**
+ * Cache line size used to keep the producer and consumer indices apart.
+ * Override it for the target (e.g. 32 on Cortex-M7, or a small value on cacheless
+ * cores such as the RP2040 to save RAM).
+ */
+#ifndef MEMCPY_SMART_PTR_CACHE_LINE_SIZE
+#define MEMCPY_SMART_PTR_CACHE_LINE_SIZE 64
+#endif
+
+// Producer policies for memcpy_ptr_ring
+struct memcpy_ring_spsc // one producer, one consumer
+{
+};
+
+struct memcpy_ring_mpsc // any number of producers, one consumer
+{
+};
+
+/**
+ * Bounded lock-free ring buffer of memcpy smart pointers.
+ *
+ * Ptr is memcpy_unique_ptr<T, ...> or memcpy_shared_ptr<T>. Items go in through
+ * Ptr::memcpy_send and are adopted straight out of their slot with Ptr::memcpy_adopt
+ * (one bitwise copy per hop in each direction), and the ring upholds
+ * the Integrity Rule itself: a slot is never overwritten before it has been
+ * received, and anything still queued when the ring is destroyed is received
+ * and released.
+ *
+ * N must be a power of two. On cores without atomic read-modify-write
+ * instructions the MPSC variant's compare-exchange goes through libatomic.
+ */
+template <class Ptr, std::size_t N, class Mode = memcpy_ring_spsc>
+class memcpy_ptr_ring;
+
+namespace memcpy_ptr_ring_detail
+{
+    template <class Ptr>
+    bool copy_in(void *const dest, const Ptr *const src)
+    {
+        memcpy(dest, static_cast<const void *>(src), sizeof(Ptr));
+        return true;
+    }
+}
+
+// Single-producer / single-consumer ring (Lamport queue with cached indices).
+template <class Ptr, std::size_t N>
+class memcpy_ptr_ring<Ptr, N, memcpy_ring_spsc>
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "memcpy_ptr_ring capacity must be a power of two");
+
+public:
+    memcpy_ptr_ring() = default;
+    memcpy_ptr_ring(const memcpy_ptr_ring &) = delete;
+    memcpy_ptr_ring &operator=(const memcpy_ptr_ring &) = delete;
+
+    ~memcpy_ptr_ring() { drain(); }
+
+    /**
+     * Producer side. Sends 'ptr' into the ring (memcpy_send semantics: a unique
+     * pointer is left empty, a shared pointer keeps its reference and the ring
+     * holds another). Returns false without touching 'ptr' if the ring is full.
+     */
+    bool push(Ptr &ptr)
+    {
+        const std::size_t tail = producer.tail.load(std::memory_order_relaxed);
+        if (tail - producer.head_cache >= N)
+        {
+            producer.head_cache = consumer.head.load(std::memory_order_acquire);
+            if (tail - producer.head_cache >= N)
+            {
+                return false; // Full
+            }
+        }
+        ptr.memcpy_send(slots[tail & (N - 1)], memcpy_ptr_ring_detail::copy_in<Ptr>);
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Receives the oldest item into 'out'; returns false if the ring is empty.
+    bool pop(Ptr &out)
+    {
+        const std::size_t head = consumer.head.load(std::memory_order_relaxed);
+        if (head == consumer.tail_cache)
+        {
+            consumer.tail_cache = producer.tail.load(std::memory_order_acquire);
+            if (head == consumer.tail_cache)
+            {
+                return false; // Empty
+            }
+        }
+        out.memcpy_adopt(slots[head & (N - 1)]);
+        consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently with push/pop
+    std::size_t size() const
+    {
+        return producer.tail.load(std::memory_order_acquire) - consumer.head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static constexpr std::size_t capacity() { return N; }
+
+private:
+    void drain()
+    {
+        Ptr item;
+        while (pop(item))
+        {
+        }
+    }
+
+    struct alignas(MEMCPY_SMART_PTR_CACHE_LINE_SIZE) producer_side
+    {
+        std::atomic<std::size_t> tail{0};
+        std::size_t head_cache = 0; // Last consumer index seen by the producer
+    };
+
+    struct alignas(MEMCPY_SMART_PTR_CACHE_LINE_SIZE) consumer_side
+    {
+        std::atomic<std::size_t> head{0};
+        std::size_t tail_cache = 0; // Last producer index seen by the consumer
+    };
+
+    producer_side producer;
+    consumer_side consumer;
+    alignas(MEMCPY_SMART_PTR_CACHE_LINE_SIZE) unsigned char slots[N][sizeof(Ptr)];
+};
+
+// Multi-producer / single-consumer ring (bounded queue with per-slot sequence numbers).
+template <class Ptr, std::size_t N>
+class memcpy_ptr_ring<Ptr, N, memcpy_ring_mpsc>
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "memcpy_ptr_ring capacity must be a power of two");
+
+public:
+    memcpy_ptr_ring()
+    {
+        for (std::size_t i = 0; i < N; i++)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    memcpy_ptr_ring(const memcpy_ptr_ring &) = delete;
+    memcpy_ptr_ring &operator=(const memcpy_ptr_ring &) = delete;
+
+    ~memcpy_ptr_ring() { drain(); }
+
+    /**
+     * Producer side, safe from any number of tasks or cores. Same ownership
+     * semantics as the SPSC ring; returns false without touching 'ptr' if full.
+     */
+    bool push(Ptr &ptr)
+    {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        slot *target;
+        for (;;)
+        {
+            target = &slots[pos & (N - 1)];
+            const std::size_t sequence = target->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0)
+            {
+                // Slot is free for this lap: claim it
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // Full: the consumer has not released this slot yet
+            }
+            else
+            {
+                pos = tail.load(std::memory_order_relaxed); // Another producer took it
+            }
+        }
+        ptr.memcpy_send(target->storage, memcpy_ptr_ring_detail::copy_in<Ptr>);
+        target->sequence.store(pos + 1, std::memory_order_release); // Publish to the consumer
+        return true;
+    }
+
+    // Consumer side (single consumer). Returns false if the oldest slot is not published yet.
+    bool pop(Ptr &out)
+    {
+        const std::size_t pos = head.load(std::memory_order_relaxed);
+        slot &source = slots[pos & (N - 1)];
+        if (source.sequence.load(std::memory_order_acquire) != pos + 1)
+        {
+            return false; // Empty (or the producer that claimed it is still copying)
+        }
+        out.memcpy_adopt(source.storage);
+        source.sequence.store(pos + N, std::memory_order_release); // Free the slot for the next lap
+        head.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Approximate when called concurrently with push/pop
+    std::size_t size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static constexpr std::size_t capacity() { return N; }
+
+private:
+    void drain()
+    {
+        Ptr item;
+        while (pop(item))
+        {
+        }
+    }
+
+    struct slot
+    {
+        std::atomic<std::size_t> sequence;
+        alignas(Ptr) unsigned char storage[sizeof(Ptr)];
+    };
+
+    alignas(MEMCPY_SMART_PTR_CACHE_LINE_SIZE) std::atomic<std::size_t> tail{0};
+    alignas(MEMCPY_SMART_PTR_CACHE_LINE_SIZE) std::atomic<std::size_t> head{0};
+    alignas(MEMCPY_SMART_PTR_CACHE_LINE_SIZE) slot slots[N];
+};
+
+template <class Ptr, std::size_t N>
+using memcpy_spsc_ring = memcpy_ptr_ring<Ptr, N, memcpy_ring_spsc>;
+
+template <class Ptr, std::size_t N>
+using memcpy_mpsc_ring = memcpy_ptr_ring<Ptr, N, memcpy_ring_mpsc>;
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // For memcpy
+#include <type_traits>
+
+#include "memcpy_lock_policy.h"
+#include "memcpy_ptr_ring.h"
+
+/**
+ * Deferred reclamation for memcpy_shared_ptr.
+ *
+ * With a deferred policy the last owner does not dispose of the object itself:
+ * the control block is queued on a lock-free retire list (O(1), no allocation)
+ * and freed later by memcpy_reclaim_drain, e.g. from a low-priority housekeeping
+ * task. Real-time consumers then never pay for a large destructor or free().
+ *
+ *     using frame_ptr = memcpy_shared_ptr<Frame, memcpy_lock_policy_deferred<>>;
+ *
+ * Only the owners' release is deferred. The last memcpy_weak_ptr of an already
+ * reclaimed block still frees the block memory itself.
+ */
+
+/**
+ * Capacity of the retire list (a power of two). When it is full the block is
+ * reclaimed right away, as without the policy, so size it for the bursts between
+ * two drains.
+ */
+#ifndef MEMCPY_SMART_PTR_RECLAIM_CAPACITY
+#define MEMCPY_SMART_PTR_RECLAIM_CAPACITY 32
+#endif
+
+class memcpy_shared_ptr_control_block;
+
+/**
+ * Lock policy wrapper: counts like Base (see memcpy_lock_policy.h) and defers the
+ * reclamation of the last owner's control block to memcpy_reclaim_drain.
+ */
+template <class Base = memcpy_default_lock_policy>
+struct memcpy_lock_policy_deferred : Base
+{
+    static constexpr bool deferred_reclaim = true;
+};
+
+// True for policies whose last release goes through the retire list
+template <class Policy, typename = void>
+struct memcpy_is_deferred_reclaim : std::false_type
+{
+};
+
+template <class Policy>
+struct memcpy_is_deferred_reclaim<Policy, std::void_t<decltype(Policy::deferred_reclaim)>>
+    : std::integral_constant<bool, Policy::deferred_reclaim>
+{
+};
+
+// One retired control block and the function that finishes it under its pointer's policy.
+struct memcpy_reclaim_entry
+{
+    memcpy_shared_ptr_control_block *block = nullptr;
+    void (*reclaim)(memcpy_shared_ptr_control_block *) = nullptr;
+
+    // memcpy_ptr_ring hooks: an entry is plain data, so send and adopt are bitwise copies
+    template <typename _Function>
+    bool memcpy_send(void *const dest, _Function copy_fn) const
+    {
+        return copy_fn(dest, this);
+    }
+
+    void memcpy_adopt(const void *const src) noexcept
+    {
+        memcpy(static_cast<void *>(this), src, sizeof(memcpy_reclaim_entry));
+    }
+};
+
+/**
+ * The retire list: any context retires, a single housekeeping context drains.
+ * Entries are plain data, so the destructor reclaims the blocks still queued
+ * rather than dropping them. For the static list that happens at program exit;
+ * call memcpy_reclaim_drain() before if the objects' destructors use other statics.
+ */
+class memcpy_reclaim_ring : public memcpy_mpsc_ring<memcpy_reclaim_entry, MEMCPY_SMART_PTR_RECLAIM_CAPACITY>
+{
+public:
+    memcpy_reclaim_ring() = default;
+
+    ~memcpy_reclaim_ring() { reclaim(SIZE_MAX); }
+
+    // Frees up to 'max_items' queued blocks and returns how many were freed.
+    std::size_t reclaim(std::size_t max_items) noexcept
+    {
+        std::size_t freed = 0;
+        memcpy_reclaim_entry entry;
+        while (freed < max_items && pop(entry))
+        {
+            entry.reclaim(entry.block);
+            freed++;
+        }
+        return freed;
+    }
+};
+
+inline memcpy_reclaim_ring &memcpy_reclaim_list() noexcept
+{
+    static memcpy_reclaim_ring list;
+    return list;
+}
+
+// Queues 'block' for reclamation; reclaims it immediately if the list is full.
+inline void memcpy_reclaim_retire(memcpy_shared_ptr_control_block *block, void (*reclaim)(memcpy_shared_ptr_control_block *)) noexcept
+{
+    memcpy_reclaim_entry entry{block, reclaim};
+    if (!memcpy_reclaim_list().push(entry))
+    {
+        reclaim(block);
+    }
+}
+
+/**
+ * Frees up to 'max_items' retired blocks (disposing of their objects) and returns
+ * how many were freed. Call it from one context at a time.
+ */
+inline std::size_t memcpy_reclaim_drain(std::size_t max_items = SIZE_MAX) noexcept
+{
+    return memcpy_reclaim_list().reclaim(max_items);
+}
+
+// Number of blocks waiting for memcpy_reclaim_drain (approximate under concurrency)
+inline std::size_t memcpy_reclaim_pending() noexcept
+{
+    return memcpy_reclaim_list().size();
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new> // For std::nothrow and placement new
+#include <type_traits>
+#include <utility>
+
+#include "memcpy_unique_pointer.h"
+
+template <class T>
+class memcpy_recycler;
+
+/**
+ * Deleter of a recycled memcpy_unique_ptr: destroys the object and returns its
+ * storage to the recycler that created it, from whichever task or core the
+ * pointer ends up on. One word, trivially copyable, so it travels with the
+ * pointer through memcpy_send / memcpy_receive.
+ */
+template <class T>
+struct memcpy_recycle_delete
+{
+    memcpy_recycler<T> *owner = nullptr;
+
+    void operator()(T *ptr) const noexcept { owner->recycle(ptr); }
+};
+
+template <class T>
+using memcpy_recycled_unique_ptr = memcpy_unique_ptr<T, memcpy_recycle_delete<T>>;
+
+/**
+ * Return-to-sender free list for memcpy_unique_ptr payloads.
+ *
+ * Owned by the creating context (one task or core). Pointers made through it
+ * are not deleted when they die: the object is destroyed in place and its
+ * storage is pushed back onto a lock-free return stack, and the next factory
+ * call on the owner reuses it. At steady state no allocation happens and the
+ * storage stays warm in the producer's cache.
+ *
+ *     memcpy_recycler<Frame> frames;           // producer side
+ *     auto frame = make_memcpy_recycled_unique_ptr(frames, args...);
+ *     frame.memcpy_send(...);                   // consumer frees it, storage comes back
+ *
+ * make and reserve must only be called by the owner; pointers may die on any
+ * task or core. All of them must be gone before the recycler is destroyed.
+ */
+template <class T>
+class memcpy_recycler
+{
+public:
+    memcpy_recycler() = default;
+    memcpy_recycler(const memcpy_recycler &) = delete;
+    memcpy_recycler &operator=(const memcpy_recycler &) = delete;
+
+    ~memcpy_recycler()
+    {
+        free_list(local);
+        free_list(returned.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    /**
+     * Constructs a T in recycled storage (a fresh allocation if none is free).
+     * Allocation failure yields an empty pointer instead of an exception.
+     */
+    template <typename... ParaTypes>
+    typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_recycled_unique_ptr<T>>::type
+    make(ParaTypes &&...paras)
+    {
+        node *slot = acquire();
+        if (slot == nullptr)
+        {
+            return memcpy_recycled_unique_ptr<T>{};
+        }
+        slot_guard guard{this, slot}; // Gives the slot back if T's constructor throws
+        T *object = memcpy_construct_at<T>(slot->storage, std::forward<ParaTypes>(paras)...);
+        guard.slot = nullptr;
+        return memcpy_recycled_unique_ptr<T>{object, memcpy_recycle_delete<T>{this}};
+    }
+
+    // Pre-allocates storage for 'count' objects so that the first pointers don't allocate either.
+    // Returns false if the heap ran out first.
+    bool reserve(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            node *fresh = new (std::nothrow) node;
+            if (fresh == nullptr)
+            {
+                return false;
+            }
+            fresh->next = local;
+            local = fresh;
+        }
+        return true;
+    }
+
+    /**
+     * Destroys 'ptr' and hands its storage back. Safe from any task or core: the
+     * storage goes onto the return stack with a compare-exchange and is only taken
+     * off by the owner, as a whole, so no ABA can occur.
+     */
+    void recycle(T *ptr) noexcept
+    {
+        ptr->~T();
+        node *slot = reinterpret_cast<node *>(ptr); // storage is the first member of node
+        node *head = returned.load(std::memory_order_relaxed);
+        do
+        {
+            slot->next = head;
+        } while (!returned.compare_exchange_weak(head, slot, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+private:
+    struct node
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+        node *next = nullptr;
+    };
+
+    // Owner only: the private free list first, then everything returned since the last refill.
+    node *acquire() noexcept
+    {
+        if (local == nullptr)
+        {
+            local = returned.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (local == nullptr)
+        {
+            return new (std::nothrow) node;
+        }
+        node *slot = local;
+        local = slot->next;
+        return slot;
+    }
+
+    // Owner only: puts an unused slot back on the private free list
+    void give_back(node *slot) noexcept
+    {
+        slot->next = local;
+        local = slot;
+    }
+
+    struct slot_guard
+    {
+        memcpy_recycler *owner;
+        node *slot;
+
+        ~slot_guard()
+        {
+            if (slot != nullptr)
+            {
+                owner->give_back(slot);
+            }
+        }
+    };
+
+    static void free_list(node *head) noexcept
+    {
+        while (head != nullptr)
+        {
+            node *next = head->next;
+            delete head;
+            head = next;
+        }
+    }
+
+    node *local = nullptr;                  // owner-private free list
+    std::atomic<node *> returned{nullptr}; // storage handed back by any context
+};
+
+/**
+ * Factory function: like make_memcpy_unique_ptr, but the object is built in storage
+ * recycled by 'recycler' and goes back there when the pointer dies.
+ */
+template <typename T, typename... ParaTypes>
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_recycled_unique_ptr<T>>::type
+make_memcpy_recycled_unique_ptr(memcpy_recycler<T> &recycler, ParaTypes &&...paras)
+{
+    return recycler.make(std::forward<ParaTypes>(paras)...);
+}
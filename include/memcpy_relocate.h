@@ -0,0 +1,53 @@
+#pragma once
+
+#include <type_traits>
+#include <cstddef>
+#include <cstring> // For memcpy
+#include <new>     // For placement new
+#include <utility>
+
+/**
+ * True for types whose objects may be moved to new storage with memcpy, the
+ * source then being treated as gone (no destructor call). Trivially copyable
+ * types qualify; the memcpy pointers specialize it next to their definitions,
+ * since the bitwise transfer contract already relies on exactly this property.
+ */
+template <class T>
+struct memcpy_is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <class T>
+constexpr bool memcpy_is_trivially_relocatable_v = memcpy_is_trivially_relocatable<T>::value;
+
+/**
+ * Relocates the objects in [first, last) into the uninitialized storage at 'dest'
+ * and returns the end of the destination range. Afterwards the source range holds
+ * no objects and must not be destroyed. For trivially relocatable types this is a
+ * single memcpy; other types are move-constructed and destroyed one by one.
+ * The ranges must not overlap.
+ *
+ * Standard containers do not know about the trait, so this is meant for the
+ * library's own buffers (queues, pools, hand-written vectors of pointers).
+ */
+template <class T>
+T *memcpy_relocate(T *first, T *last, T *dest) noexcept(memcpy_is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible<T>::value)
+{
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    if constexpr (memcpy_is_trivially_relocatable_v<T>)
+    {
+        if (count != 0)
+        {
+            memcpy(static_cast<void *>(dest), static_cast<const void *>(first), count * sizeof(T));
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            ::new (static_cast<void *>(dest + i)) T(std::move(first[i]));
+            first[i].~T();
+        }
+    }
+    return dest + count;
+}
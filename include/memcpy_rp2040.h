@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring> // For memcpy
+#include <type_traits>
+#include <utility>
+
+#include "pico/multicore.h"
+#include "hardware/sync.h"
+
+#include "memcpy_lock_policy.h"
+#include "memcpy_shared_pointer.h"
+#include "memcpy_unique_pointer.h"
+
+/**
+ * RP2040 core-to-core transport (requires the Pico SDK; link pico_multicore).
+ *
+ * The SIO FIFO carries 32-bit words, eight deep in each direction. A one-word
+ * memcpy_unique_ptr goes through it as its own bits, and a memcpy_shared_ptr as
+ * its control block alone (see memcpy_shared_ptr::memcpy_send_block), so either
+ * hand-off is a single push and a single pop. Both follow the memcpy_send /
+ * memcpy_receive ownership rules: a sent pointer is empty (or, for a shared
+ * pointer, has registered the new owner) and the receiver owns what it pops.
+ *
+ * The Cortex-M0+ has no atomic read-modify-write and masking interrupts only
+ * excludes the current core, so a pointer shared by both cores needs
+ * memcpy_lock_policy_rp2040_spinlock (memcpy_multicore_shared_ptr<T>); the shared
+ * FIFO overloads below reject any other policy at compile time.
+ *
+ * Nothing else may use the FIFO in the meantime (the SDK's multicore_lockout and
+ * multicore_launch_core1 do, briefly).
+ */
+
+/**
+ * Hardware spinlock taken by memcpy_lock_policy_rp2040_spinlock. The SIO spinlocks
+ * are not recursive, so it must not be one an RTOS may already hold around user code
+ * (the FreeRTOS SMP port takes PICO_SPINLOCK_ID_OS1 and OS2). By default one is
+ * claimed from the SDK's free range during static initialization; define
+ * MEMCPY_SMART_PTR_RP2040_SPINLOCK_ID to pin a lock reserved for it instead.
+ */
+#if defined(MEMCPY_SMART_PTR_RP2040_SPINLOCK_ID)
+inline spin_lock_t *memcpy_rp2040_spinlock() noexcept { return spin_lock_instance(MEMCPY_SMART_PTR_RP2040_SPINLOCK_ID); }
+#else
+inline spin_lock_t *const memcpy_rp2040_claimed_spinlock = spin_lock_instance(static_cast<uint>(spin_lock_claim_unused(true)));
+
+inline spin_lock_t *memcpy_rp2040_spinlock() noexcept { return memcpy_rp2040_claimed_spinlock; }
+#endif
+
+/**
+ * Counter updates inside one of the SIO hardware spinlocks, with interrupts masked
+ * on the calling core: safe between both cores and their interrupt handlers, and a
+ * few cycles longer than the single-core critical section.
+ */
+struct memcpy_lock_policy_rp2040_spinlock
+{
+    // Interrupts are masked while the spinlock is held
+    static constexpr bool isr_safe = true;
+
+    static void increment(memcpy_shared_ptr_counter &count, memcpy_ref_count_t n = 1)
+    {
+        guard lock;
+        memcpy_lock_policy_single::increment(count, n);
+    }
+
+    static memcpy_ref_count_t decrement(memcpy_shared_ptr_counter &count, memcpy_ref_count_t n = 1)
+    {
+        guard lock;
+        return memcpy_lock_policy_single::decrement(count, n);
+    }
+
+    static bool increment_if_nonzero(memcpy_shared_ptr_counter &count)
+    {
+        guard lock;
+        return memcpy_lock_policy_single::increment_if_nonzero(count);
+    }
+
+    static memcpy_ref_count_t get_count(const memcpy_shared_ptr_counter &count) { return count.load(std::memory_order_relaxed); }
+
+private:
+    class guard
+    {
+    public:
+        guard() noexcept : lock(memcpy_rp2040_spinlock()), saved(spin_lock_blocking(lock)) {}
+        ~guard() { spin_unlock(lock, saved); }
+
+        guard(const guard &) = delete;
+        guard &operator=(const guard &) = delete;
+
+    private:
+        spin_lock_t *const lock;
+        const uint32_t saved;
+    };
+};
+
+// Shared pointer whose count may be updated from both cores
+template <class T>
+using memcpy_multicore_shared_ptr = memcpy_shared_ptr<T, memcpy_lock_policy_rp2040_spinlock>;
+
+// Same as make_memcpy_shared_ptr, for a memcpy_multicore_shared_ptr.
+template <typename T, typename... ParaTypes>
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_multicore_shared_ptr<T>>::type
+make_memcpy_multicore_shared_ptr(ParaTypes &&...paras)
+{
+    return memcpy_multicore_shared_ptr<T>{
+        new memcpy_shared_ptr_control_block_inplace<T>(std::forward<ParaTypes>(paras)...)};
+}
+
+// --- memcpy_unique_ptr: the pointer's bits are the word ---
+
+/**
+ * Pushes 'ptr' to the other core, waiting while the FIFO is full.
+ * Only one-word pointers qualify (single objects with a stateless deleter).
+ */
+template <class T, class Deleter>
+bool memcpy_fifo_send(memcpy_unique_ptr<T, Deleter> &ptr)
+{
+    using Ptr = memcpy_unique_ptr<T, Deleter>;
+    static_assert(sizeof(Ptr) == sizeof(uint32_t), "only one-word pointers fit a FIFO entry");
+    return ptr.memcpy_send(nullptr, [](void *const, const Ptr *const src)
+                           {
+                               uint32_t word;
+                               memcpy(&word, static_cast<const void *>(src), sizeof(word));
+                               multicore_fifo_push_blocking(word);
+                               return true; });
+}
+
+// Like memcpy_fifo_send, but returns false (keeping the object) instead of waiting for space.
+template <class T, class Deleter>
+bool memcpy_fifo_try_send(memcpy_unique_ptr<T, Deleter> &ptr)
+{
+    return multicore_fifo_wready() && memcpy_fifo_send(ptr);
+}
+
+// Pops a pointer sent from the other core into 'ptr' (releasing its current object), waiting for one to arrive.
+template <class T, class Deleter>
+void memcpy_fifo_receive(memcpy_unique_ptr<T, Deleter> &ptr)
+{
+    static_assert(sizeof(memcpy_unique_ptr<T, Deleter>) == sizeof(uint32_t), "only one-word pointers fit a FIFO entry");
+    const uint32_t word = multicore_fifo_pop_blocking();
+    ptr.memcpy_adopt(&word);
+}
+
+// Like memcpy_fifo_receive, waiting at most 'timeout_us'. Returns false if nothing arrived.
+template <class T, class Deleter>
+bool memcpy_fifo_receive_timeout_us(memcpy_unique_ptr<T, Deleter> &ptr, uint64_t timeout_us)
+{
+    static_assert(sizeof(memcpy_unique_ptr<T, Deleter>) == sizeof(uint32_t), "only one-word pointers fit a FIFO entry");
+    uint32_t word;
+    if (!multicore_fifo_pop_timeout_us(timeout_us, &word))
+    {
+        return false;
+    }
+    ptr.memcpy_adopt(&word);
+    return true;
+}
+
+// --- memcpy_shared_ptr: the control block is the word ---
+
+// Both cores update the count of a pointer sent over the FIFO: only the spinlock policy (or a wrapper of it) qualifies
+template <class Policy>
+constexpr bool memcpy_is_multicore_policy = std::is_base_of<memcpy_lock_policy_rp2040_spinlock, Policy>::value;
+
+// Pushes a new owner of 'ptr' to the other core, waiting while the FIFO is full.
+template <class T, class Policy>
+bool memcpy_fifo_send(memcpy_shared_ptr<T, Policy> &ptr)
+{
+    static_assert(memcpy_is_multicore_policy<Policy>, "use a memcpy_multicore_shared_ptr to share an object between the cores");
+    return ptr.memcpy_send_block([](memcpy_shared_ptr_control_block *const block)
+                                 {
+                                     multicore_fifo_push_blocking(reinterpret_cast<uintptr_t>(block));
+                                     return true; });
+}
+
+template <class T, class Policy>
+bool memcpy_fifo_try_send(memcpy_shared_ptr<T, Policy> &ptr)
+{
+    return multicore_fifo_wready() && memcpy_fifo_send(ptr);
+}
+
+template <class T, class Policy>
+void memcpy_fifo_receive(memcpy_shared_ptr<T, Policy> &ptr)
+{
+    static_assert(memcpy_is_multicore_policy<Policy>, "use a memcpy_multicore_shared_ptr to share an object between the cores");
+    ptr.memcpy_adopt_block(reinterpret_cast<memcpy_shared_ptr_control_block *>(multicore_fifo_pop_blocking()));
+}
+
+template <class T, class Policy>
+bool memcpy_fifo_receive_timeout_us(memcpy_shared_ptr<T, Policy> &ptr, uint64_t timeout_us)
+{
+    static_assert(memcpy_is_multicore_policy<Policy>, "use a memcpy_multicore_shared_ptr to share an object between the cores");
+    uint32_t word;
+    if (!multicore_fifo_pop_timeout_us(timeout_us, &word))
+    {
+        return false;
+    }
+    ptr.memcpy_adopt_block(reinterpret_cast<memcpy_shared_ptr_control_block *>(word));
+    return true;
+}
@@ -1,63 +1,169 @@
+#pragma once
+
 #include <type_traits>
-#include <ext/atomicity.h> // For _Atomic_word
-#include <ext/concurrence.h> // For __gnu_cxx lock policies
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // For memcpy
+#include <new>     // For placement new and std::launder
+#include <utility>
+
+#include "memcpy_construct.h"
+#include "memcpy_lock_policy.h"
+#include "memcpy_object_pool.h"
+#include "memcpy_reclaim.h"
+#include "memcpy_relocate.h"
+#include "memcpy_stats.h"
+#include "memcpy_transfer_tracker.h"
 
 /**
- * Base template for the reference counter. 
- * Uses __gnu_cxx lock policies to differentiate between atomic and non-atomic counting.
+ * Control block shared by every owner of a managed object.
+ * Besides the reference counters it knows how to dispose of the managed object
+ * and how to free itself, so memcpy_shared_ptr does not need to know whether
+ * the object was allocated on its own or fused into the block.
+ *
+ * The object lives while use_count is non-zero; the block lives while weak_count
+ * is. All owners together hold a single weak reference, so a block without
+ * memcpy_weak_ptr observers is freed together with its object.
  */
-template <__gnu_cxx::_Lock_policy _Lp = __gnu_cxx::__default_lock_policy>
-class memcpy_shared_ptr_count;
+class memcpy_shared_ptr_control_block
+{
+public:
+    // Destroys the managed object (called once, by the last owner)
+    virtual void dispose() noexcept = 0;
+
+    // Frees the control block itself (called after dispose)
+    virtual void destroy() noexcept { delete this; }
+
+    // The managed object (its first element for arrays), until dispose
+    virtual void *object() noexcept = 0;
+
+    // Number of owners, updated through the lock policy of the pointers (see memcpy_lock_policy.h)
+    memcpy_shared_ptr_counter use_count{1};
 
-// Specialization for single-threaded environments: No atomic overhead.
-template <>
-class memcpy_shared_ptr_count<__gnu_cxx::_S_single>
+    // Number of memcpy_weak_ptr observers, plus one while any owner remains
+    memcpy_shared_ptr_counter weak_count{1};
+
+protected:
+    virtual ~memcpy_shared_ptr_control_block() = default;
+};
+
+// Control block for an object allocated separately, e.g. memcpy_shared_ptr<T>{new T(...)}.
+// For memcpy_shared_ptr<T[]> it owns an array from new[].
+template <class T>
+class memcpy_shared_ptr_control_block_ptr final : public memcpy_shared_ptr_control_block
 {
 public:
-    memcpy_shared_ptr_count() : count(1) {}
+    explicit memcpy_shared_ptr_control_block_ptr(std::remove_extent_t<T> *ptr) noexcept : ptr(ptr)
+    {
+        if (ptr != nullptr)
+        {
+            memcpy_stats<std::remove_extent_t<T>>::on_allocate();
+        }
+    }
 
-    void increment() { count++; }
-    void decrement() { count--; }
+    void *object() noexcept override { return ptr; }
 
-    _Atomic_word get_count() const { return count; }
+    void dispose() noexcept override
+    {
+        if (ptr != nullptr)
+        {
+            memcpy_stats<std::remove_extent_t<T>>::on_free();
+        }
+        if constexpr (std::is_array<T>::value)
+        {
+            delete[] ptr;
+        }
+        else
+        {
+            delete ptr;
+        }
+    }
 
 private:
-    _Atomic_word count;
+    std::remove_extent_t<T> *ptr;
+};
+
+// Allocation strategy for a fused block: the global heap, unless T opted into a pool.
+struct memcpy_shared_ptr_heap_allocated
+{
 };
 
-// Specialization for multi-threaded environments: Uses std::atomic for thread safety.
-template <>
-class memcpy_shared_ptr_count<__gnu_cxx::_S_atomic>
+template <class Block, class T, bool = memcpy_is_pool_allocated<T>::value>
+struct memcpy_shared_ptr_block_allocation
+{
+    using type = memcpy_shared_ptr_heap_allocated;
+};
+
+// A pooled T gets a companion pool holding the same number of fused blocks.
+template <class Block, class T>
+struct memcpy_shared_ptr_block_allocation<Block, T, true>
+{
+    using type = memcpy_pool_allocated<Block, T::memcpy_pool_capacity>;
+};
+
+/**
+ * Fused control block: the counter and the managed object share one allocation.
+ * Used by make_memcpy_shared_ptr so that creating a pointer costs a single heap
+ * allocation (or pool slot) and the object sits right next to its counter.
+ * The storage of the object is only freed with the block, i.e. once the last
+ * memcpy_weak_ptr is gone as well.
+ */
+template <class T>
+class memcpy_shared_ptr_control_block_inplace final
+    : public memcpy_shared_ptr_control_block,
+      public memcpy_shared_ptr_block_allocation<memcpy_shared_ptr_control_block_inplace<T>, T>::type
 {
 public:
-    memcpy_shared_ptr_count() : count(1) {}
+    template <typename... ParaTypes>
+    explicit memcpy_shared_ptr_control_block_inplace(ParaTypes &&...paras)
+    {
+        memcpy_construct_at<T>(storage, std::forward<ParaTypes>(paras)...);
+        memcpy_stats<T>::on_allocate();
+    }
 
-    void increment() { count++; }
-    void decrement() { count--; }
+    // Default-initializes the object (make_memcpy_shared_ptr_for_overwrite)
+    explicit memcpy_shared_ptr_control_block_inplace(memcpy_for_overwrite_t)
+    {
+        ::new (static_cast<void *>(storage)) T;
+        memcpy_stats<T>::on_allocate();
+    }
+
+    T *get() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
 
-    _Atomic_word get_count() const { return count.load(); }
+    void *object() noexcept override { return get(); }
+
+    void dispose() noexcept override
+    {
+        get()->~T();
+        memcpy_stats<T>::on_free();
+    }
 
 private:
-    std::atomic<_Atomic_word> count;
+    alignas(T) unsigned char storage[sizeof(T)];
 };
 
+template <class T, class Policy = memcpy_default_lock_policy>
+class memcpy_shared_ptr;
+
+template <class T, class Policy = memcpy_default_lock_policy>
+class memcpy_weak_ptr;
+
 /**
  * RAII Management class for the reference counter object.
- * This handles the allocation and life-cycle of the counter itself, 
- * but does NOT manage the user's data pointer (that's handled by memcpy_shared_ptr).
+ * Each instance holds one reference on the control block. Dropping the
+ * last reference disposes of the managed object and frees the block.
  */
-template <__gnu_cxx::_Lock_policy _Lp>
+template <class Policy>
 class memcpy_shared_ptr_object_count
 {
 public:
     memcpy_shared_ptr_object_count() : count(nullptr) {}
 
-    // Initialize counter for a new raw pointer
-    template <typename Ptr>
-    explicit memcpy_shared_ptr_object_count(Ptr p) : count(nullptr)
+    // Initialize counter for a new raw pointer (T is the managed type, T[] for arrays)
+    template <typename T>
+    explicit memcpy_shared_ptr_object_count(memcpy_shared_ptr_control_block_ptr<T> *block) : count(block)
     {
-        count = new memcpy_shared_ptr_count<_Lp>{};
     }
 
     // Copy Constructor: Increments reference count
@@ -65,22 +171,19 @@ public:
     {
         if (count != nullptr)
         {
-            count->increment();
+            Policy::increment(count->use_count);
         }
     }
 
-    // Copy Assignment: Decrements old count and increments new count
+    // Copy Assignment: Takes the new reference before dropping the old one (safe for self-assignment)
     memcpy_shared_ptr_object_count &operator=(const memcpy_shared_ptr_object_count &obj)
     {
-        if (count != nullptr)
+        if (obj.count != nullptr)
         {
-            count->decrement();
+            Policy::increment(obj.count->use_count);
         }
+        release();
         count = obj.count;
-        if (count != nullptr)
-        {
-            count->increment();
-        }
         return *this;
     }
 
@@ -90,43 +193,132 @@ public:
         obj.count = nullptr;
     }
 
-    // Move Assignment: Cleans up current counter and takes over the new one
+    // Move Assignment: Drops the current reference and takes over the new one
     memcpy_shared_ptr_object_count &operator=(memcpy_shared_ptr_object_count &&obj)
     {
-        count = std::move(obj.count);
-        obj.count = nullptr;
+        if (this != &obj)
+        {
+            release();
+            count = obj.count;
+            obj.count = nullptr;
+        }
         return *this;
     }
 
-    // Destructor: Decrements count (Cleanup of the counter memory is handled in memcpy_shared_ptr)
-    ~memcpy_shared_ptr_object_count()
+    ~memcpy_shared_ptr_object_count() { release(); }
+
+    /**
+     * Drops this instance's reference.
+     * Whether this was the last owner is decided from the value the decrement
+     * returns, never from a separate load, so two owners releasing at the same
+     * time cannot both (or neither) free the block.
+     */
+    void release() noexcept
     {
         if (count != nullptr)
         {
-            count->decrement();
+            release(count, 1);
+            count = nullptr;
+        }
+    }
+
+    /**
+     * Drops n owners of 'block'. The last owner disposes of the object and gives up
+     * the owners' weak reference, or hands both to the retire list under a deferred
+     * policy (see memcpy_reclaim.h).
+     */
+    static void release(memcpy_shared_ptr_control_block *const block, const memcpy_ref_count_t n) noexcept
+    {
+        if (Policy::decrement(block->use_count, n) == n)
+        {
+            if constexpr (memcpy_is_deferred_reclaim<Policy>::value)
+            {
+                memcpy_reclaim_retire(block, &reclaim);
+            }
+            else
+            {
+                reclaim(block);
+            }
+        }
+    }
+
+    // Finishes a block whose last owner is gone
+    static void reclaim(memcpy_shared_ptr_control_block *const block) noexcept
+    {
+        block->dispose();
+        release_weak(block);
+    }
+
+    // Drops one weak reference; the last one frees the block.
+    static void release_weak(memcpy_shared_ptr_control_block *const block) noexcept
+    {
+        if (Policy::decrement(block->weak_count) == 1)
+        {
+            block->destroy();
         }
     }
 
 private:
-    memcpy_shared_ptr_count<_Lp> *count;
+    memcpy_shared_ptr_control_block *count;
 
-    // Grant access to the main smart pointer class
-    template <class T>
+    // Grant access to the smart pointer classes (of every lock policy)
+    template <class T, class>
     friend class memcpy_shared_ptr;
+
+    template <class T, class>
+    friend class memcpy_weak_ptr;
 };
 
 /**
  * A shared pointer compatible with C-style memcpy functions.
  * Designed for RTOS Queues and buffers where the memory is eventually 
  * copied back out into a class instance to maintain ownership tracking.
+ *
+ * Policy selects how the reference count is updated (see memcpy_lock_policy.h).
+ * The default follows the platform; memcpy_local_shared_ptr uses the single-threaded
+ * policy for pointers that never leave one task.
+ *
+ * memcpy_shared_ptr<T[]> shares an array from new[] and releases it with delete[].
  */
-template <class T>
+template <class T, class Policy>
 class memcpy_shared_ptr
 {
+    using counter_policy = Policy;
+    using stats = memcpy_stats<std::remove_extent_t<T>>;
+    using tracker = memcpy_transfer_tracker<std::remove_extent_t<T>>;
+
 public:
+    using element_type = std::remove_extent_t<T>;
+
     memcpy_shared_ptr() : ptr(nullptr), refCount{} {}
 
-    memcpy_shared_ptr(T *ptr) : ptr(ptr), refCount(ptr) {}
+    // Empty, like the default constructor (and not ambiguous with the control block constructor)
+    memcpy_shared_ptr(std::nullptr_t) : memcpy_shared_ptr() {}
+
+    memcpy_shared_ptr(element_type *ptr) : ptr(ptr), refCount(new memcpy_shared_ptr_control_block_ptr<T>{ptr}) {}
+
+    // Adopts a fused control block (see make_memcpy_shared_ptr); the block already holds one reference.
+    // A null block (pool exhausted) yields an empty pointer.
+    explicit memcpy_shared_ptr(memcpy_shared_ptr_control_block_inplace<T> *block)
+        : ptr(block != nullptr ? block->get() : nullptr), refCount{}
+    {
+        refCount.count = block;
+    }
+
+    /**
+     * Aliasing constructors: share the owners (and the lifetime) of 'owner', but point
+     * at 'alias', typically a sub-object of the owner's object such as a frame's
+     * payload. get() and every transfer carry the alias; the last owner still frees
+     * the original allocation. The moving form leaves 'owner' empty.
+     */
+    template <class U>
+    memcpy_shared_ptr(const memcpy_shared_ptr<U, Policy> &owner, element_type *alias) : ptr{alias}, refCount{owner.refCount} {}
+
+    template <class U>
+    memcpy_shared_ptr(memcpy_shared_ptr<U, Policy> &&owner, element_type *alias) : ptr{alias}, refCount{std::move(owner.refCount)}
+    {
+        owner.ptr = nullptr;
+    }
 
     // Copy logic
     memcpy_shared_ptr(const memcpy_shared_ptr &obj) : ptr{obj.ptr}, refCount{obj.refCount} {}
@@ -135,10 +327,9 @@ public:
     {
         if (refCount.count != obj.refCount.count)
         {
-            __cleanup__(); 
-            this->ptr = obj.ptr;
-            this->refCount = obj.refCount;
+            this->refCount = obj.refCount; // Releases the old reference
         }
+        this->ptr = obj.ptr; // Aliases of one owner may point at different sub-objects
         return *this;
     }
 
@@ -150,108 +341,618 @@ public:
 
     memcpy_shared_ptr &operator=(memcpy_shared_ptr &&obj)
     {
-        if (refCount.count != obj.refCount.count)
+        if (this != &obj)
         {
-            __cleanup__();
             this->ptr = obj.ptr;
-            this->refCount = std::move(obj.refCount);
+            this->refCount = std::move(obj.refCount); // Releases the old reference
             obj.ptr = nullptr;
         }
         return *this;
     }
 
     // Accessors
-    _Atomic_word get_count() const { return refCount.count == nullptr ? 0 : refCount.count->get_count(); }
-    T *get() const { return this->ptr; }
-    T *operator->() const { return this->ptr; }
-    T &operator*() const { return *this->ptr; }
+    memcpy_ref_count_t get_count() const { return refCount.count == nullptr ? 0 : counter_policy::get_count(refCount.count->use_count); }
+    element_type *get() const { return this->ptr; }
+    element_type *operator->() const { return this->ptr; }
+    element_type &operator*() const { return *this->ptr; }
+
+    // True if both pointers share one control block (the same owners), even when empty
+    bool owner_equal(const memcpy_shared_ptr &other) const noexcept { return refCount.count == other.refCount.count; }
+
+    // Element access for memcpy_shared_ptr<T[]>
+    template <class U = T, typename std::enable_if<std::is_array<U>::value, int>::type = 0>
+    element_type &operator[](std::size_t index) const { return this->ptr[index]; }
 
     // SFINAE checks for C-API compatibility
     template <typename _Function>
-    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_shared_ptr<T> *const>;
+    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_shared_ptr *const>;
 
     template <typename _Function>
-    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_shared_ptr<T> *const, const void *const>;
+    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_shared_ptr *const, const void *const>;
 
     /**
      * Bridges C++ ownership to C-style Send.
      * Increments refCount because the bitwise copy in 'dest' becomes a new 'owner'.
+     * The owner is registered before the copy, since the receiver (e.g. a task woken
+     * by xQueueSend, or the other core) may release it before the copy function returns.
      */
     template <typename _Function>
     typename std::enable_if<is_memcpy_send_signature<_Function>, bool>::type memcpy_send(void *const dest, _Function copy_fn)
     {
         bool success = false;
+        tracker::sent(refCount.count); // Before the copy: the receiver may claim it right away
+        register_owner();
         if (copy_fn(dest, this))
         {
-            if (nullptr != refCount.count)
-            {
-                refCount.count->increment(); // Register the new bitwise owner
-            }
+            stats::on_send();
             success = true;
         }
+        else
+        {
+            unregister_owner(); // Not sent after all
+            tracker::received(refCount.count);
+        }
         return success;
     }
 
     /**
      * Bridges C-style Receive to C++ ownership.
-     * Decrements the count of the current instance before taking over the bitwise-received data.
+     * Releases the current instance's reference before taking over the bitwise-received data.
+     * If 'this' is empty the copy function writes straight into it (one copy per hop).
+     * On failure the copy function must leave the destination untouched, as xQueueReceive does.
      */
     template <typename _Function>
     typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type memcpy_receive(const void *const src, _Function copy_fn)
     {
-        uint8_t buffer[sizeof(memcpy_shared_ptr<T>)];
+        if (nullptr == refCount.count)
+        {
+            ptr = nullptr;
+            return copy_fn(this, src) && claim(this); // Nothing to release: receive in place
+        }
+
+        uint8_t buffer[sizeof(memcpy_shared_ptr)];
         bool success = false;
-        if (copy_fn(reinterpret_cast<memcpy_shared_ptr<T> *>(buffer), src))
+        if (copy_fn(reinterpret_cast<memcpy_shared_ptr *>(buffer), src) &&
+            claim(reinterpret_cast<memcpy_shared_ptr *>(buffer)))
         {
-            if (nullptr != refCount.count)
+            __cleanup__(); // Relinquish current reference
+            // Perform the bitwise transfer into 'this' instance
+            memcpy(static_cast<void *>(this), buffer, sizeof(memcpy_shared_ptr));
+            success = true;
+        }
+        return success;
+    }
+
+    /**
+     * memcpy_send for interrupt handlers (e.g. a DMA-complete ISR around xQueueSendFromISR).
+     * The new bitwise owner is registered through the pointer's own policy, which must
+     * be ISR safe: task code updates the same counter, and only one exclusion
+     * mechanism for both sides makes the update atomic. No allocation, no libatomic
+     * calls, no loops beyond the copy function.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_send_signature<_Function>, bool>::type
+    memcpy_send_from_isr(void *const dest, _Function copy_fn) noexcept
+    {
+        static_assert(Policy::isr_safe, "memcpy_send_from_isr needs an ISR-safe lock policy (e.g. memcpy_lock_policy_critical_section)");
+        tracker::sent(refCount.count);
+        register_owner();
+        const bool success = copy_fn(dest, this);
+        if (success)
+        {
+            stats::on_send();
+        }
+        else
+        {
+            unregister_owner(); // Never the last owner: nothing is freed
+            tracker::received(refCount.count);
+        }
+        return success;
+    }
+
+    /**
+     * memcpy_receive for interrupt handlers (e.g. around xQueueReceiveFromISR).
+     * Receiving transfers the sender's reference bitwise, so no counter is touched.
+     * Releasing a current object could free memory, which an ISR must not do, so
+     * the receive only happens into an empty pointer; otherwise it returns false
+     * without calling the copy function.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type
+    memcpy_receive_from_isr(const void *const src, _Function copy_fn) noexcept
+    {
+        return nullptr == refCount.count && copy_fn(this, src) && claim(this);
+    }
+
+    /**
+     * Claims ownership directly from addressable storage holding a sent pointer
+     * (e.g. a slot of a ring buffer in RAM). Costs a single bitwise copy; the
+     * source bytes must not be received again afterwards.
+     */
+    void memcpy_adopt(const void *const src) noexcept
+    {
+        __cleanup__();
+        memcpy(static_cast<void *>(this), src, sizeof(memcpy_shared_ptr));
+        claim(this);
+    }
+
+    // --- One-word C-API Bridge (e.g. the RP2040 SIO FIFO, see memcpy_rp2040.h) ---
+
+    template <typename _Function>
+    constexpr static bool is_memcpy_send_block_signature = std::is_invocable_r_v<bool, _Function, memcpy_shared_ptr_control_block *const>;
+
+    /**
+     * memcpy_send for transports that carry a single word: the copy function gets
+     * the control block only, which is enough to rebuild the pointer on the other
+     * side with memcpy_adopt_block. Same ownership rules as memcpy_send; an empty
+     * pointer sends nullptr. Fails for an aliasing pointer, which needs memcpy_send.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_send_block_signature<_Function>, bool>::type memcpy_send_block(_Function copy_fn)
+    {
+        if (is_alias())
+        {
+            return false; // The block alone cannot carry the aliased pointer
+        }
+        bool success = false;
+        tracker::sent(refCount.count);
+        register_owner();
+        if (copy_fn(refCount.count))
+        {
+            stats::on_send();
+            success = true;
+        }
+        else
+        {
+            unregister_owner();
+            tracker::received(refCount.count);
+        }
+        return success;
+    }
+
+    // Takes over an owner sent with memcpy_send_block, releasing the current one first.
+    void memcpy_adopt_block(memcpy_shared_ptr_control_block *const block) noexcept
+    {
+        __cleanup__();
+        refCount.count = block;
+        ptr = block != nullptr ? static_cast<element_type *>(block->object()) : nullptr;
+        claim(this);
+    }
+
+    // SFINAE checks for the batched C-API bridge
+    template <typename _Function>
+    constexpr static bool is_memcpy_send_batch_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_shared_ptr *const, const std::size_t>;
+
+    template <typename _Function>
+    constexpr static bool is_memcpy_receive_batch_signature = std::is_invocable_r_v<bool, _Function, memcpy_shared_ptr *const, const void *const, const std::size_t>;
+
+    /**
+     * Sends 'count' contiguous pointers with a single call to the copy function.
+     * Each bitwise copy becomes a new owner; neighbouring pointers that share a
+     * control block are registered with one counter update instead of one each.
+     */
+    template <typename _Function>
+    static typename std::enable_if<is_memcpy_send_batch_signature<_Function>, bool>::type
+    memcpy_send_batch(memcpy_shared_ptr *const ptrs, const std::size_t count, void *const dest, _Function copy_fn)
+    {
+        bool success = false;
+        for (std::size_t i = 0; i < count;)
+        {
+            std::size_t run = __run_length__(ptrs, count, i);
+            ptrs[i].register_owner(static_cast<memcpy_ref_count_t>(run));
+            for (std::size_t j = i; j < i + run; j++)
             {
-                refCount.count->decrement(); // Relinquish current reference
+                tracker::sent(ptrs[j].refCount.count);
             }
-            __cleanup__();
-            // Perform the bitwise transfer into 'this' instance
-            memcpy(this, buffer, sizeof(memcpy_shared_ptr<T>));
+            i += run;
+        }
+        if (copy_fn(dest, ptrs, count))
+        {
+            stats::on_send(static_cast<uint32_t>(count));
             success = true;
         }
+        else
+        {
+            for (std::size_t i = 0; i < count;)
+            {
+                std::size_t run = __run_length__(ptrs, count, i);
+                ptrs[i].unregister_owner(static_cast<memcpy_ref_count_t>(run));
+                for (std::size_t j = i; j < i + run; j++)
+                {
+                    tracker::received(ptrs[j].refCount.count);
+                }
+                i += run;
+            }
+        }
+        return success;
+    }
+
+    template <std::size_t N, typename _Function>
+    static typename std::enable_if<is_memcpy_send_batch_signature<_Function>, bool>::type
+    memcpy_send_batch(memcpy_shared_ptr (&ptrs)[N], void *const dest, _Function copy_fn)
+    {
+        return memcpy_send_batch(ptrs, N, dest, copy_fn);
+    }
+
+    /**
+     * Claims 'count' contiguous pointers with a single call to the copy function.
+     * The destination objects are released first (one counter update per run of
+     * pointers sharing a block) and the copy function then writes straight into
+     * them. If the copy fails the destinations are left empty; the copy function
+     * must not write on failure.
+     */
+    template <typename _Function>
+    static typename std::enable_if<is_memcpy_receive_batch_signature<_Function>, bool>::type
+    memcpy_receive_batch(memcpy_shared_ptr *const ptrs, const std::size_t count, const void *const src, _Function copy_fn)
+    {
+        for (std::size_t i = 0; i < count;)
+        {
+            std::size_t run = __run_length__(ptrs, count, i);
+            auto *block = ptrs[i].refCount.count;
+            if (nullptr != block)
+            {
+                memcpy_shared_ptr_object_count<Policy>::release(block, static_cast<memcpy_ref_count_t>(run));
+            }
+            for (std::size_t j = i; j < i + run; j++)
+            {
+                ptrs[j].refCount.count = nullptr;
+                ptrs[j].ptr = nullptr;
+            }
+            i += run;
+        }
+        const bool success = copy_fn(ptrs, src, count);
+        if (success)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                claim(&ptrs[i]); // A rejected copy leaves its element empty
+            }
+        }
         return success;
     }
 
+    template <std::size_t N, typename _Function>
+    static typename std::enable_if<is_memcpy_receive_batch_signature<_Function>, bool>::type
+    memcpy_receive_batch(memcpy_shared_ptr (&ptrs)[N], const void *const src, _Function copy_fn)
+    {
+        return memcpy_receive_batch(ptrs, N, src, copy_fn);
+    }
+
+    /**
+     * Checked conversion to a pointer with another lock policy, e.g. from a
+     * memcpy_local_shared_ptr to the atomic flavour before it crosses a task boundary.
+     * Only the sole owner without weak observers may convert: other pointers would
+     * keep updating the shared counters under the old policy. On success ownership
+     * moves into 'out' at no cost (the control block is shared by all policies) and
+     * this pointer is left empty.
+     */
+    template <class OtherPolicy>
+    bool convert_lock_policy(memcpy_shared_ptr<T, OtherPolicy> &out)
+    {
+        if (get_count() > 1 || (refCount.count != nullptr && counter_policy::get_count(refCount.count->weak_count) > 1))
+        {
+            return false;
+        }
+        out.__cleanup__();
+        out.ptr = ptr;
+        out.refCount.count = refCount.count;
+        ptr = nullptr;
+        refCount.count = nullptr;
+        return true;
+    }
+
     ~memcpy_shared_ptr() { __cleanup__(); }
 
 public:
-    T *ptr = nullptr;
-    memcpy_shared_ptr_object_count<__gnu_cxx::__default_lock_policy> refCount;
+    element_type *ptr = nullptr;
+    memcpy_shared_ptr_object_count<Policy> refCount;
 
     /**
-     * Internal cleanup: Checks if this is the last owner.
-     * If count <= 1, it deletes both the counter and the raw data.
+     * Internal cleanup: Releases this owner's reference.
+     * The last owner disposes of the managed object and frees the control block.
      */
     void __cleanup__()
     {
-        if (refCount.count != nullptr)
+        refCount.release();
+        ptr = nullptr;
+    }
+
+    // True if this pointer does not point at the object its control block manages (see the aliasing constructors)
+    bool is_alias() const noexcept
+    {
+        const void *const object = refCount.count != nullptr ? refCount.count->object() : nullptr;
+        return static_cast<const void *>(ptr) != object;
+    }
+
+    // Registers 'n' new bitwise owners of this pointer's object (none when empty)
+    void register_owner(const memcpy_ref_count_t n = 1) noexcept
+    {
+        if (nullptr != refCount.count)
+        {
+            counter_policy::increment(refCount.count->use_count, n);
+        }
+    }
+
+    // Takes back owners registered for a send that failed; this pointer still owns, so nothing is freed
+    void unregister_owner(const memcpy_ref_count_t n = 1) noexcept
+    {
+        if (nullptr != refCount.count)
+        {
+            counter_policy::decrement(refCount.count->use_count, n);
+        }
+    }
+
+    // Accepts the bits just received into 'dest', or drops a duplicated copy (see memcpy_transfer_tracker.h)
+    static bool claim(memcpy_shared_ptr *const dest) noexcept
+    {
+        if (!tracker::received(dest->refCount.count))
+        {
+            dest->refCount.count = nullptr; // Not an owner: drop the bits without releasing
+            dest->ptr = nullptr;
+            return false;
+        }
+        stats::on_receive();
+        return true;
+    }
+
+    // Number of consecutive pointers starting at 'first' that share one control block
+    static std::size_t __run_length__(const memcpy_shared_ptr *const ptrs, const std::size_t count, const std::size_t first)
+    {
+        std::size_t run = 1;
+        while (first + run < count && ptrs[first + run].refCount.count == ptrs[first].refCount.count)
+        {
+            run++;
+        }
+        return run;
+    }
+};
+
+/**
+ * A non-owning observer of a memcpy_shared_ptr, e.g. for lookaside caches of
+ * frames that should not be kept alive by the cache itself.
+ *
+ * lock() returns an owning pointer if the object still exists, or an empty one;
+ * with the atomic policy it never blocks. Like memcpy_shared_ptr it can travel
+ * through C-style buffers: memcpy_send registers a new weak reference for the
+ * bitwise copy and memcpy_receive takes it over.
+ *
+ * To give a large object's memory back as soon as the last owner is gone, create
+ * it with memcpy_shared_ptr<T>{new T(...)}: a fused block from make_memcpy_shared_ptr
+ * keeps the object's storage until the last weak pointer is released too.
+ */
+template <class T, class Policy>
+class memcpy_weak_ptr
+{
+    using counter_policy = Policy;
+    using object_count = memcpy_shared_ptr_object_count<Policy>;
+
+public:
+    memcpy_weak_ptr() : ptr(nullptr), count(nullptr) {}
+
+    memcpy_weak_ptr(const memcpy_shared_ptr<T, Policy> &owner) : ptr(owner.ptr), count(owner.refCount.count)
+    {
+        acquire();
+    }
+
+    memcpy_weak_ptr(const memcpy_weak_ptr &obj) : ptr(obj.ptr), count(obj.count)
+    {
+        acquire();
+    }
+
+    memcpy_weak_ptr &operator=(const memcpy_weak_ptr &obj)
+    {
+        if (count != obj.count)
+        {
+            __cleanup__();
+            count = obj.count;
+            acquire();
+        }
+        ptr = obj.ptr; // Observers of one block may point at different sub-objects
+        return *this;
+    }
+
+    memcpy_weak_ptr &operator=(const memcpy_shared_ptr<T, Policy> &owner)
+    {
+        return *this = memcpy_weak_ptr{owner};
+    }
+
+    memcpy_weak_ptr(memcpy_weak_ptr &&dyingObj) : ptr(dyingObj.ptr), count(dyingObj.count)
+    {
+        dyingObj.ptr = nullptr;
+        dyingObj.count = nullptr;
+    }
+
+    memcpy_weak_ptr &operator=(memcpy_weak_ptr &&obj)
+    {
+        if (this != &obj)
         {
-            if ((refCount.count->get_count()) <= 1)
+            __cleanup__();
+            ptr = obj.ptr;
+            count = obj.count;
+            obj.ptr = nullptr;
+            obj.count = nullptr;
+        }
+        return *this;
+    }
+
+    ~memcpy_weak_ptr() { __cleanup__(); }
+
+    /**
+     * Takes a new reference on the object unless its last owner is already gone.
+     * The count is only ever incremented from a non-zero value, so an object being
+     * disposed of is never handed out again.
+     */
+    memcpy_shared_ptr<T, Policy> lock() const
+    {
+        memcpy_shared_ptr<T, Policy> locked;
+        if (count != nullptr && counter_policy::increment_if_nonzero(count->use_count))
+        {
+            locked.ptr = ptr;
+            locked.refCount.count = count;
+        }
+        return locked;
+    }
+
+    // Number of owners of the observed object (0 once it has been disposed of)
+    memcpy_ref_count_t get_count() const { return count == nullptr ? 0 : counter_policy::get_count(count->use_count); }
+
+    bool expired() const { return get_count() == 0; }
+
+    void reset() { __cleanup__(); }
+
+    // SFINAE checks for C-API compatibility
+    template <typename _Function>
+    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_weak_ptr *const>;
+
+    template <typename _Function>
+    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_weak_ptr *const, const void *const>;
+
+    /**
+     * Bridges a weak reference to C-style Send.
+     * The bitwise copy in 'dest' becomes a new observer, so the weak count is incremented,
+     * before the copy: the receiver may drop the observer (and with it the last weak
+     * reference) as soon as the bits are in the queue.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_send_signature<_Function>, bool>::type memcpy_send(void *const dest, _Function copy_fn)
+    {
+        acquire(); // Register the new bitwise observer
+        if (!copy_fn(dest, this))
+        {
+            if (count != nullptr)
             {
-                delete refCount.count;
-                refCount.count = nullptr;
-                delete ptr;
-                ptr = nullptr;
+                counter_policy::decrement(count->weak_count); // This observer remains: never the last
             }
+            return false;
         }
-        else
+        return true;
+    }
+
+    /**
+     * Bridges C-style Receive to a weak reference.
+     * Releases the current weak reference before taking over the received one; an
+     * empty pointer is written in place. On failure the copy function must not write.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type memcpy_receive(const void *const src, _Function copy_fn)
+    {
+        if (nullptr == count)
         {
-            // Edge case: Pointer exists but no count object (e.g. error in allocation)
-            delete ptr;
             ptr = nullptr;
+            return copy_fn(this, src);
+        }
+
+        uint8_t buffer[sizeof(memcpy_weak_ptr)];
+        bool success = false;
+        if (copy_fn(reinterpret_cast<memcpy_weak_ptr *>(buffer), src))
+        {
+            __cleanup__();
+            memcpy(static_cast<void *>(this), buffer, sizeof(memcpy_weak_ptr));
+            success = true;
         }
+        return success;
+    }
+
+    // Claims a sent weak pointer directly from addressable storage (see memcpy_shared_ptr::memcpy_adopt).
+    void memcpy_adopt(const void *const src) noexcept
+    {
+        __cleanup__();
+        memcpy(static_cast<void *>(this), src, sizeof(memcpy_weak_ptr));
+    }
+
+private:
+    std::remove_extent_t<T> *ptr;
+    memcpy_shared_ptr_control_block *count;
+
+    void acquire()
+    {
+        if (count != nullptr)
+        {
+            counter_policy::increment(count->weak_count);
+        }
+    }
+
+    // Internal cleanup: Releases this observer's weak reference.
+    void __cleanup__()
+    {
+        if (count != nullptr)
+        {
+            object_count::release_weak(count);
+        }
+        ptr = nullptr;
+        count = nullptr;
     }
 };
 
 /**
  * Helper function to create a memcpy_shared_ptr with a new object.
+ * The object is constructed inside its control block, so this costs one allocation.
+ * For a T derived from memcpy_pool_allocated the block comes from a pool, and an
+ * exhausted pool yields an empty pointer.
  */
 template <typename T, typename... ParaTypes>
-typename std::enable_if<std::is_constructible<T, ParaTypes...>::value, memcpy_shared_ptr<T>>::type
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_shared_ptr<T>>::type
 make_memcpy_shared_ptr(ParaTypes &&...paras)
 {
-    return memcpy_shared_ptr<T>{new T(std::forward<ParaTypes...>(paras...))};
-}
\ No newline at end of file
+    return memcpy_shared_ptr<T>{
+        new memcpy_shared_ptr_control_block_inplace<T>(std::forward<ParaTypes>(paras)...)};
+}
+
+// Same as make_memcpy_shared_ptr<T>(), but the object is default-initialized (see make_memcpy_unique_ptr_for_overwrite).
+template <typename T>
+typename std::enable_if<!std::is_array<T>::value && std::is_default_constructible<T>::value, memcpy_shared_ptr<T>>::type
+make_memcpy_shared_ptr_for_overwrite()
+{
+    return memcpy_shared_ptr<T>{new memcpy_shared_ptr_control_block_inplace<T>(memcpy_for_overwrite)};
+}
+
+// Shared pointer with a non-atomic counter, for objects that stay within one task.
+template <class T>
+using memcpy_local_shared_ptr = memcpy_shared_ptr<T, memcpy_lock_policy_single>;
+
+// Same as make_memcpy_shared_ptr, for a memcpy_local_shared_ptr.
+template <typename T, typename... ParaTypes>
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_local_shared_ptr<T>>::type
+make_memcpy_local_shared_ptr(ParaTypes &&...paras)
+{
+    return memcpy_local_shared_ptr<T>{
+        new memcpy_shared_ptr_control_block_inplace<T>(std::forward<ParaTypes>(paras)...)};
+}
+
+/**
+ * Aliasing helper: a pointer to one member of the object 'owner' points at, sharing
+ * its owners, e.g. memcpy_shared_member(frame, &Frame::payload). An array member
+ * yields a pointer to its first element. Empty if 'owner' is.
+ */
+template <class T, class Policy, class M, class C>
+memcpy_shared_ptr<std::remove_extent_t<M>, Policy> memcpy_shared_member(const memcpy_shared_ptr<T, Policy> &owner, M C::*member)
+{
+    static_assert(std::is_base_of<C, T>::value, "'member' must belong to the owner's type");
+    using member_ptr = memcpy_shared_ptr<std::remove_extent_t<M>, Policy>;
+    if (owner.get() == nullptr)
+    {
+        return member_ptr{};
+    }
+    if constexpr (std::is_array<M>::value)
+    {
+        return member_ptr{owner, &(owner.get()->*member)[0]};
+    }
+    else
+    {
+        return member_ptr{owner, &(owner.get()->*member)};
+    }
+}
+
+// Owners refer to the control block, never to each other: a bitwise move keeps the count exact.
+template <class T, class Policy>
+struct memcpy_is_trivially_relocatable<memcpy_shared_ptr<T, Policy>> : std::true_type
+{
+};
+
+template <class T, class Policy>
+struct memcpy_is_trivially_relocatable<memcpy_weak_ptr<T, Policy>> : std::true_type
+{
+};
+
+static_assert(sizeof(memcpy_shared_ptr<int>) == 2 * sizeof(void *), "memcpy_shared_ptr must stay two pointers wide");
+static_assert(sizeof(memcpy_weak_ptr<int>) == 2 * sizeof(void *), "memcpy_weak_ptr must stay two pointers wide");
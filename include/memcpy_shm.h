@@ -0,0 +1,639 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // For memcpy
+#include <new>     // For placement new and std::launder
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "memcpy_construct.h"
+#include "memcpy_relocate.h"
+
+/**
+ * Inter-process mode for POSIX hosts (Linux gateways): smart pointers whose objects
+ * live in a named shared-memory arena and whose representation is an offset into
+ * it, so the zero-copy hand-off also works between processes that map the arena
+ * at different addresses.
+ *
+ *     memcpy_shm_arena arena;
+ *     arena.create("/telemetry", 1 << 20, 0);                 // producer
+ *     auto *ring = arena.construct<memcpy_ptr_ring<memcpy_shm_unique_ptr<Frame>, 64>>();
+ *     arena.set_root(ring);
+ *
+ *     memcpy_shm_arena arena;
+ *     arena.open("/telemetry");                               // consumer
+ *     auto *ring = arena.root<memcpy_ptr_ring<memcpy_shm_unique_ptr<Frame>, 64>>();
+ *
+ * A pointer is one 64-bit handle: the arena id (chosen at create) and an offset.
+ * Each process resolves the id through its own table of open arenas, so handles
+ * go through memcpy_send / memcpy_receive, and through any shared-memory queue,
+ * unchanged. Objects placed in an arena must not hold process-local pointers.
+ *
+ * Counters and the allocator lock are lock-free std::atomic objects in the arena
+ * (address-free, hence process-shared). A process that dies while allocating
+ * leaves the allocator locked.
+ */
+
+// Number of arenas a process can have open at once (ids 0 .. N-1)
+#ifndef MEMCPY_SMART_PTR_SHM_ARENAS
+#define MEMCPY_SMART_PTR_SHM_ARENAS 4
+#endif
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "memcpy_shm needs address-free (lock-free) atomics to share them between processes");
+
+using memcpy_shm_handle = uint64_t;
+
+/**
+ * A named shared-memory region with a small first-fit allocator. Every block keeps
+ * its size, and freed blocks are reused by later allocations of the same or a
+ * smaller size (no coalescing, so size the arena for the mix of message types).
+ */
+class memcpy_shm_arena
+{
+public:
+    memcpy_shm_arena() noexcept = default;
+    memcpy_shm_arena(const memcpy_shm_arena &) = delete;
+    memcpy_shm_arena &operator=(const memcpy_shm_arena &) = delete;
+
+    ~memcpy_shm_arena() { close(); }
+
+    // Creates and maps a new arena of 'bytes' bytes. Fails if 'name' exists or 'id' is taken in this process.
+    bool create(const char *name, std::size_t bytes, uint8_t id) noexcept
+    {
+        if (base != nullptr || id >= MEMCPY_SMART_PTR_SHM_ARENAS || table()[id] != nullptr || bytes <= sizeof(header))
+        {
+            return false;
+        }
+        const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+        {
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0 || !map(fd, bytes))
+        {
+            ::close(fd);
+            shm_unlink(name);
+            return false;
+        }
+        ::close(fd);
+
+        header *const h = ::new (base) header{};
+        h->id = id;
+        h->capacity = bytes;
+        h->top = round_up(sizeof(header));
+        h->magic.store(header_magic, std::memory_order_release); // Last: a concurrent open only accepts a ready arena
+        table()[id] = this;
+        return true;
+    }
+
+    // Maps an arena created by another process (or this one).
+    bool open(const char *name) noexcept
+    {
+        if (base != nullptr)
+        {
+            return false;
+        }
+        const int fd = shm_open(name, O_RDWR, 0600);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat info;
+        const bool mapped = fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) > sizeof(header) &&
+                            map(fd, static_cast<std::size_t>(info.st_size));
+        ::close(fd);
+        if (!mapped)
+        {
+            return false;
+        }
+        header *const h = head();
+        if (h->magic.load(std::memory_order_acquire) != header_magic || h->id >= MEMCPY_SMART_PTR_SHM_ARENAS || table()[h->id] != nullptr)
+        {
+            unmap();
+            return false;
+        }
+        table()[h->id] = this;
+        return true;
+    }
+
+    // Unmaps the arena in this process (the region and its objects stay for the others)
+    void close() noexcept
+    {
+        if (base != nullptr)
+        {
+            if (table()[head()->id] == this)
+            {
+                table()[head()->id] = nullptr;
+            }
+            unmap();
+        }
+    }
+
+    // Removes the name; the memory goes away once every process has closed it.
+    static bool unlink(const char *name) noexcept { return shm_unlink(name) == 0; }
+
+    explicit operator bool() const noexcept { return base != nullptr; }
+
+    uint8_t id() const noexcept { return head()->id; }
+
+    // --- Allocation (any process, any thread) ---
+
+    // Returns nullptr when the arena is exhausted. 'alignment' is a power of two.
+    void *allocate(std::size_t bytes, std::size_t alignment = granularity) noexcept
+    {
+        const uint64_t size = round_up(sizeof(chunk) + bytes);
+        header *const h = head();
+        guard lock{h->lock};
+
+        uint64_t *link = &h->free_head;
+        while (*link != 0)
+        {
+            chunk *const candidate = at<chunk>(*link);
+            if (candidate->size >= size && (*link + sizeof(chunk)) % alignment == 0)
+            {
+                const uint64_t offset = *link;
+                *link = candidate->next;
+                return payload(offset);
+            }
+            link = &candidate->next;
+        }
+
+        // The mapping is page aligned, so aligning the offset aligns the address
+        const uint64_t offset = ((h->top + sizeof(chunk) + alignment - 1) & ~uint64_t{alignment - 1}) - sizeof(chunk);
+        if (offset > h->capacity || h->capacity - offset < size)
+        {
+            return nullptr;
+        }
+        h->top = offset + size;
+        ::new (base + offset) chunk{size, 0};
+        return payload(offset);
+    }
+
+    void deallocate(void *ptr) noexcept
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+        header *const h = head();
+        const uint64_t offset = to_offset(ptr) - sizeof(chunk);
+        guard lock{h->lock};
+        at<chunk>(offset)->next = h->free_head;
+        h->free_head = offset;
+    }
+
+    // Builds a T in the arena (nullptr when it is full), e.g. a memcpy_ptr_ring both processes use.
+    template <class T, class... ParaTypes>
+    T *construct(ParaTypes &&...paras)
+    {
+        void *const storage = allocate(sizeof(T), alignof(T));
+        return storage == nullptr ? nullptr : memcpy_construct_at<T>(storage, std::forward<ParaTypes>(paras)...);
+    }
+
+    template <class T>
+    void destroy(T *object) noexcept
+    {
+        if (object != nullptr)
+        {
+            object->~T();
+            deallocate(object);
+        }
+    }
+
+    // A well-known object other processes can find (e.g. the queue between them)
+    template <class T>
+    void set_root(T *object) noexcept
+    {
+        head()->root.store(object == nullptr ? 0 : to_offset(object), std::memory_order_release);
+    }
+
+    template <class T>
+    T *root() const noexcept
+    {
+        const uint64_t offset = head()->root.load(std::memory_order_acquire);
+        return offset == 0 ? nullptr : std::launder(reinterpret_cast<T *>(base + offset));
+    }
+
+    // --- Handles ---
+
+    memcpy_shm_handle to_handle(const void *ptr) const noexcept
+    {
+        return ptr == nullptr ? 0 : (static_cast<memcpy_shm_handle>(head()->id) << offset_bits) | to_offset(ptr);
+    }
+
+    // Resolves a handle through the arenas open in this process (nullptr if its arena is not open here)
+    static void *resolve(const memcpy_shm_handle handle) noexcept
+    {
+        if (handle == 0)
+        {
+            return nullptr;
+        }
+        memcpy_shm_arena *const arena = table()[handle >> offset_bits];
+        return arena == nullptr ? nullptr : arena->base + (handle & offset_mask);
+    }
+
+    // Arena a handle belongs to, in this process
+    static memcpy_shm_arena *owner(const memcpy_shm_handle handle) noexcept
+    {
+        return handle == 0 ? nullptr : table()[handle >> offset_bits];
+    }
+
+private:
+    static constexpr std::size_t granularity = 16; // chunk sizes and default alignment
+    static constexpr uint32_t header_magic = 0x4D534850; // "MSHP"
+    static constexpr unsigned offset_bits = 56;
+    static constexpr memcpy_shm_handle offset_mask = (memcpy_shm_handle{1} << offset_bits) - 1;
+
+    static_assert(MEMCPY_SMART_PTR_SHM_ARENAS <= 256, "the arena id is stored in the top byte of a handle");
+
+    struct header
+    {
+        std::atomic<uint32_t> magic{0}; // Stored with release once the rest of the header is written
+        uint8_t id = 0;
+        std::atomic<uint32_t> lock{0};
+        uint64_t capacity = 0;
+        uint64_t top = 0;       // bump pointer
+        uint64_t free_head = 0; // freed chunks, newest first
+        std::atomic<uint64_t> root{0};
+    };
+
+    static_assert(decltype(header::magic)::is_always_lock_free, "other processes read the magic word while the creator writes it");
+
+    struct chunk
+    {
+        uint64_t size; // including this header
+        uint64_t next; // free list link
+    };
+
+    static_assert(sizeof(chunk) % granularity == 0, "payloads must stay aligned");
+
+    class guard
+    {
+    public:
+        explicit guard(std::atomic<uint32_t> &lock) noexcept : lock(lock)
+        {
+            while (lock.exchange(1, std::memory_order_acquire) != 0)
+            {
+            }
+        }
+        ~guard() { lock.store(0, std::memory_order_release); }
+
+        guard(const guard &) = delete;
+        guard &operator=(const guard &) = delete;
+
+    private:
+        std::atomic<uint32_t> &lock;
+    };
+
+    static memcpy_shm_arena **table() noexcept
+    {
+        static memcpy_shm_arena *open_arenas[MEMCPY_SMART_PTR_SHM_ARENAS] = {};
+        return open_arenas;
+    }
+
+    static uint64_t round_up(uint64_t bytes) noexcept { return (bytes + granularity - 1) & ~uint64_t{granularity - 1}; }
+
+    bool map(int fd, std::size_t bytes) noexcept
+    {
+        void *const mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            return false;
+        }
+        base = static_cast<unsigned char *>(mapping);
+        mapped_bytes = bytes;
+        return true;
+    }
+
+    void unmap() noexcept
+    {
+        munmap(base, mapped_bytes);
+        base = nullptr;
+        mapped_bytes = 0;
+    }
+
+    header *head() const noexcept { return std::launder(reinterpret_cast<header *>(base)); }
+
+    template <class T>
+    T *at(uint64_t offset) const noexcept
+    {
+        return std::launder(reinterpret_cast<T *>(base + offset));
+    }
+
+    void *payload(uint64_t chunk_offset) const noexcept { return base + chunk_offset + sizeof(chunk); }
+
+    uint64_t to_offset(const void *ptr) const noexcept
+    {
+        return static_cast<uint64_t>(static_cast<const unsigned char *>(ptr) - base);
+    }
+
+    unsigned char *base = nullptr;
+    std::size_t mapped_bytes = 0;
+};
+
+/**
+ * memcpy_unique_ptr for an object in a memcpy_shm_arena. Same ownership rules and
+ * memcpy_send / memcpy_receive / memcpy_adopt hooks; the object is destroyed and
+ * its block returned to the arena by whichever process owns the pointer last.
+ */
+template <class T>
+class memcpy_shm_unique_ptr
+{
+public:
+    memcpy_shm_unique_ptr() noexcept = default;
+
+    // Takes ownership of an object built with memcpy_shm_arena::construct
+    explicit memcpy_shm_unique_ptr(const memcpy_shm_arena &arena, T *object) noexcept : handle(arena.to_handle(object)) {}
+
+    memcpy_shm_unique_ptr(const memcpy_shm_unique_ptr &) = delete;
+    memcpy_shm_unique_ptr &operator=(const memcpy_shm_unique_ptr &) = delete;
+
+    memcpy_shm_unique_ptr(memcpy_shm_unique_ptr &&dyingObj) noexcept : handle(dyingObj.handle)
+    {
+        dyingObj.handle = 0;
+    }
+
+    memcpy_shm_unique_ptr &operator=(memcpy_shm_unique_ptr &&dyingObj) noexcept
+    {
+        if (this != &dyingObj)
+        {
+            reset();
+            handle = dyingObj.handle;
+            dyingObj.handle = 0;
+        }
+        return *this;
+    }
+
+    ~memcpy_shm_unique_ptr() { reset(); }
+
+    // --- Accessors (resolved through the arenas open in this process) ---
+    T *get() const noexcept { return std::launder(static_cast<T *>(memcpy_shm_arena::resolve(handle))); }
+    T *operator->() const noexcept { return get(); }
+    T &operator*() const noexcept { return *get(); }
+
+    memcpy_shm_handle get_handle() const noexcept { return handle; }
+
+    explicit operator bool() const noexcept { return handle != 0; }
+
+    void reset() noexcept
+    {
+        memcpy_shm_arena *const arena = memcpy_shm_arena::owner(handle);
+        if (arena != nullptr)
+        {
+            arena->destroy(get());
+        }
+        handle = 0; // Not open in this process: left to the processes that have it mapped
+    }
+
+    // --- C-API Bridge Interface (SFINAE Guarded) ---
+
+    template <typename _Function>
+    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_shm_unique_ptr *const>;
+
+    template <typename _Function>
+    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_shm_unique_ptr *const, const void *const>;
+
+    // Same contract as memcpy_unique_ptr::memcpy_send: on success the handle belongs to the bits in 'dest'.
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_send_signature<_Function>, bool>::type
+    memcpy_send(void *const dest, _Function copy_fn_src)
+    {
+        bool success = false;
+        if (copy_fn_src(dest, this))
+        {
+            handle = 0;
+            success = true;
+        }
+        return success;
+    }
+
+    // Same contract as memcpy_unique_ptr::memcpy_receive.
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type
+    memcpy_receive(const void *const src, _Function copy_fn_dest)
+    {
+        if (handle == 0)
+        {
+            return copy_fn_dest(this, src); // Nothing to release: receive in place
+        }
+
+        alignas(memcpy_shm_unique_ptr) uint8_t buffer[sizeof(memcpy_shm_unique_ptr)];
+        bool success = false;
+        if (copy_fn_dest(reinterpret_cast<memcpy_shm_unique_ptr *>(buffer), src))
+        {
+            reset();
+            memcpy(static_cast<void *>(this), buffer, sizeof(memcpy_shm_unique_ptr));
+            success = true;
+        }
+        return success;
+    }
+
+    void memcpy_adopt(const void *const src) noexcept
+    {
+        reset();
+        memcpy(static_cast<void *>(this), src, sizeof(memcpy_shm_unique_ptr));
+    }
+
+private:
+    memcpy_shm_handle handle = 0;
+};
+
+// Object and counter of a memcpy_shm_shared_ptr, fused in one arena block.
+template <class T>
+struct memcpy_shm_shared_block
+{
+    std::atomic<uint32_t> use_count{1};
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *get() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+};
+
+/**
+ * memcpy_shared_ptr for an object in a memcpy_shm_arena, owned from any number of
+ * processes. The count sits next to the object in the arena. Same ownership rules
+ * as memcpy_shared_ptr: memcpy_send registers the bitwise copy as a new owner
+ * (before the copy, since the other process may release it at once) and
+ * memcpy_receive / memcpy_adopt take it over.
+ */
+template <class T>
+class memcpy_shm_shared_ptr
+{
+    using block = memcpy_shm_shared_block<T>;
+
+public:
+    memcpy_shm_shared_ptr() noexcept = default;
+
+    // Adopts a block from make_memcpy_shm_shared_ptr (holding one reference)
+    memcpy_shm_shared_ptr(const memcpy_shm_arena &arena, block *owned) noexcept : handle(arena.to_handle(owned)) {}
+
+    memcpy_shm_shared_ptr(const memcpy_shm_shared_ptr &obj) noexcept : handle(obj.handle)
+    {
+        register_owner();
+    }
+
+    memcpy_shm_shared_ptr &operator=(const memcpy_shm_shared_ptr &obj) noexcept
+    {
+        if (handle != obj.handle)
+        {
+            obj.register_owner();
+            reset();
+            handle = obj.handle;
+        }
+        return *this;
+    }
+
+    memcpy_shm_shared_ptr(memcpy_shm_shared_ptr &&dyingObj) noexcept : handle(dyingObj.handle)
+    {
+        dyingObj.handle = 0;
+    }
+
+    memcpy_shm_shared_ptr &operator=(memcpy_shm_shared_ptr &&dyingObj) noexcept
+    {
+        if (this != &dyingObj)
+        {
+            reset();
+            handle = dyingObj.handle;
+            dyingObj.handle = 0;
+        }
+        return *this;
+    }
+
+    ~memcpy_shm_shared_ptr() { reset(); }
+
+    // --- Accessors ---
+    T *get() const noexcept
+    {
+        block *const owned = get_block();
+        return owned == nullptr ? nullptr : owned->get();
+    }
+    T *operator->() const noexcept { return get(); }
+    T &operator*() const noexcept { return *get(); }
+
+    uint32_t get_count() const noexcept
+    {
+        block *const owned = get_block();
+        return owned == nullptr ? 0 : owned->use_count.load(std::memory_order_relaxed);
+    }
+
+    memcpy_shm_handle get_handle() const noexcept { return handle; }
+
+    explicit operator bool() const noexcept { return handle != 0; }
+
+    // Drops this owner; the last one, in whichever process, destroys the object
+    void reset() noexcept
+    {
+        block *const owned = get_block();
+        if (owned != nullptr && owned->use_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            owned->get()->~T();
+            memcpy_shm_arena::owner(handle)->destroy(owned);
+        }
+        handle = 0; // A handle whose arena is not open here resolves to no block and owns nothing
+    }
+
+    // --- C-API Bridge Interface (SFINAE Guarded) ---
+
+    template <typename _Function>
+    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_shm_shared_ptr *const>;
+
+    template <typename _Function>
+    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_shm_shared_ptr *const, const void *const>;
+
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_send_signature<_Function>, bool>::type
+    memcpy_send(void *const dest, _Function copy_fn)
+    {
+        register_owner();
+        if (!copy_fn(dest, this))
+        {
+            get_block()->use_count.fetch_sub(1, std::memory_order_relaxed); // This owner remains: never the last
+            return false;
+        }
+        return true;
+    }
+
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type
+    memcpy_receive(const void *const src, _Function copy_fn)
+    {
+        if (handle == 0)
+        {
+            return copy_fn(this, src); // Nothing to release: receive in place
+        }
+
+        alignas(memcpy_shm_shared_ptr) uint8_t buffer[sizeof(memcpy_shm_shared_ptr)];
+        bool success = false;
+        if (copy_fn(reinterpret_cast<memcpy_shm_shared_ptr *>(buffer), src))
+        {
+            reset();
+            memcpy(static_cast<void *>(this), buffer, sizeof(memcpy_shm_shared_ptr));
+            success = true;
+        }
+        return success;
+    }
+
+    void memcpy_adopt(const void *const src) noexcept
+    {
+        reset();
+        memcpy(static_cast<void *>(this), src, sizeof(memcpy_shm_shared_ptr));
+    }
+
+private:
+    memcpy_shm_handle handle = 0;
+
+    block *get_block() const noexcept { return std::launder(static_cast<block *>(memcpy_shm_arena::resolve(handle))); }
+
+    void register_owner() const noexcept
+    {
+        block *const owned = get_block();
+        if (owned != nullptr)
+        {
+            owned->use_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * Factory functions: auto frame = make_memcpy_shm_unique_ptr<Frame>(arena, args...);
+ * An exhausted arena yields an empty pointer.
+ */
+template <typename T, typename... ParaTypes>
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_shm_unique_ptr<T>>::type
+make_memcpy_shm_unique_ptr(memcpy_shm_arena &arena, ParaTypes &&...paras)
+{
+    return memcpy_shm_unique_ptr<T>{arena, arena.construct<T>(std::forward<ParaTypes>(paras)...)};
+}
+
+template <typename T, typename... ParaTypes>
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_shm_shared_ptr<T>>::type
+make_memcpy_shm_shared_ptr(memcpy_shm_arena &arena, ParaTypes &&...paras)
+{
+    memcpy_shm_shared_block<T> *const owned = arena.construct<memcpy_shm_shared_block<T>>();
+    if (owned != nullptr)
+    {
+        memcpy_construct_at<T>(owned->storage, std::forward<ParaTypes>(paras)...);
+    }
+    return memcpy_shm_shared_ptr<T>{arena, owned};
+}
+
+// A handle is plain data: a bitwise move is a move.
+template <class T>
+struct memcpy_is_trivially_relocatable<memcpy_shm_unique_ptr<T>> : std::true_type
+{
+};
+
+template <class T>
+struct memcpy_is_trivially_relocatable<memcpy_shm_shared_ptr<T>> : std::true_type
+{
+};
+
+static_assert(sizeof(memcpy_shm_unique_ptr<int>) == sizeof(memcpy_shm_handle), "memcpy_shm_unique_ptr is one handle");
+static_assert(sizeof(memcpy_shm_shared_ptr<int>) == sizeof(memcpy_shm_handle), "memcpy_shm_shared_ptr is one handle");
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Non-owning view of a contiguous buffer: a pointer plus an element count.
+ * Returned by memcpy_unique_ptr<T[]>::span() so the length of a sample block
+ * travels with it; C++17 has no std::span.
+ */
+template <class T>
+class memcpy_span
+{
+public:
+    constexpr memcpy_span() noexcept : ptr(nullptr), length(0) {}
+    constexpr memcpy_span(T *ptr, std::size_t length) noexcept : ptr(ptr), length(length) {}
+
+    template <std::size_t N>
+    constexpr memcpy_span(T (&array)[N]) noexcept : ptr(array), length(N) {}
+
+    constexpr T *data() const noexcept { return ptr; }
+    constexpr std::size_t size() const noexcept { return length; }
+    constexpr std::size_t size_bytes() const noexcept { return length * sizeof(T); }
+    constexpr bool empty() const noexcept { return length == 0; }
+
+    constexpr T &operator[](std::size_t index) const noexcept { return ptr[index]; }
+
+    constexpr T *begin() const noexcept { return ptr; }
+    constexpr T *end() const noexcept { return ptr + length; }
+
+    // Elements [offset, offset + count)
+    constexpr memcpy_span subspan(std::size_t offset, std::size_t count) const noexcept
+    {
+        return memcpy_span{ptr + offset, count};
+    }
+
+private:
+    T *ptr;
+    std::size_t length;
+};
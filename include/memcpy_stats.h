@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Opt-in instrumentation of the smart pointers, per managed type.
+ *
+ * Build with MEMCPY_SMART_PTR_STATS=1 to count for every type, or specialize
+ * memcpy_stats_enabled<T> to count for selected types only:
+ *
+ *     template <> struct memcpy_stats_enabled<Frame> : std::true_type {};
+ *     ...
+ *     memcpy_stats_snapshot s = memcpy_stats<Frame>::snapshot();
+ *
+ * memcpy_unique_ptr and memcpy_shared_ptr report every object they take over
+ * (allocations) and release (frees), every pointer copied into a C buffer by a
+ * successful memcpy_send and every pointer claimed back by memcpy_receive or
+ * memcpy_adopt. Sends minus receives is the number of bitwise owners parked in
+ * queues; a value that keeps growing points at a broken Integrity Rule.
+ *
+ * Disabled types have no counters and every hook is an empty inline function, so
+ * the release build is unchanged. The counters are relaxed std::atomic updates;
+ * on cores without atomic instructions they go through libatomic.
+ */
+#ifndef MEMCPY_SMART_PTR_STATS
+#define MEMCPY_SMART_PTR_STATS 0
+#endif
+
+template <class T>
+struct memcpy_stats_enabled : std::integral_constant<bool, MEMCPY_SMART_PTR_STATS != 0>
+{
+};
+
+// Counters of one managed type at one point in time (each read on its own; approximate under concurrency)
+struct memcpy_stats_snapshot
+{
+    uint32_t allocations = 0;
+    uint32_t frees = 0;
+    uint32_t sends = 0;
+    uint32_t receives = 0;
+    uint32_t in_flight = 0; // sends - receives: bitwise owners still in C buffers
+    uint32_t live = 0;      // allocations - frees
+    uint32_t peak_live = 0;
+};
+
+template <class T>
+class memcpy_stats
+{
+public:
+    static constexpr bool enabled = memcpy_stats_enabled<T>::value;
+
+    static void on_allocate() noexcept
+    {
+        if constexpr (enabled)
+        {
+            const uint32_t now = allocations.fetch_add(1, std::memory_order_relaxed) + 1 - frees.load(std::memory_order_relaxed);
+            uint32_t peak = peak_live.load(std::memory_order_relaxed);
+            while (now > peak && !peak_live.compare_exchange_weak(peak, now, std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+
+    static void on_free() noexcept
+    {
+        if constexpr (enabled)
+        {
+            frees.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static void on_send(uint32_t count = 1) noexcept
+    {
+        if constexpr (enabled)
+        {
+            sends.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    static void on_receive(uint32_t count = 1) noexcept
+    {
+        if constexpr (enabled)
+        {
+            receives.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    // All zero for a disabled type
+    static memcpy_stats_snapshot snapshot() noexcept
+    {
+        memcpy_stats_snapshot result;
+        if constexpr (enabled)
+        {
+            result.allocations = allocations.load(std::memory_order_relaxed);
+            result.frees = frees.load(std::memory_order_relaxed);
+            result.sends = sends.load(std::memory_order_relaxed);
+            result.receives = receives.load(std::memory_order_relaxed);
+            result.in_flight = result.sends - result.receives;
+            result.live = result.allocations - result.frees;
+            result.peak_live = peak_live.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    /**
+     * Starts a new measurement window. Objects still alive and pointers still in
+     * flight are carried over as allocations and sends, so live and in_flight stay
+     * right; everything else restarts at zero. Call it while the type is quiet.
+     */
+    static void reset() noexcept
+    {
+        if constexpr (enabled)
+        {
+            const uint32_t live = allocations.load(std::memory_order_relaxed) - frees.load(std::memory_order_relaxed);
+            const uint32_t in_flight = sends.load(std::memory_order_relaxed) - receives.load(std::memory_order_relaxed);
+            allocations.store(live, std::memory_order_relaxed);
+            frees.store(0, std::memory_order_relaxed);
+            sends.store(in_flight, std::memory_order_relaxed);
+            receives.store(0, std::memory_order_relaxed);
+            peak_live.store(live, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    // Only instantiated (and only take space) for enabled types
+    inline static std::atomic<uint32_t> allocations{0};
+    inline static std::atomic<uint32_t> frees{0};
+    inline static std::atomic<uint32_t> sends{0};
+    inline static std::atomic<uint32_t> receives{0};
+    inline static std::atomic<uint32_t> peak_live{0};
+};
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "memcpy_lock_policy.h"
+
+/**
+ * Field-test tracking of bitwise transfers. Build with MEMCPY_SMART_PTR_TRACK_TRANSFERS=1
+ * to track every type, or specialize memcpy_transfer_tracked<T> to track selected ones.
+ *
+ * Every memcpy_send of a memcpy_unique_ptr or memcpy_shared_ptr records
+ * the object it carries in a fixed side table, stamped with a sequence number;
+ * memcpy_receive and memcpy_adopt check the record off. The pointers keep their
+ * layout, so the tracked build talks to the same queues as the release build.
+ *
+ * - A copy that is received although nothing of it is in flight (received twice,
+ *   or never sent) is rejected instead of becoming a second owner: the receive
+ *   returns false and the destination is left empty, so the worst case is a leak
+ *   rather than a double free. Rejections are counted and passed to
+ *   MEMCPY_SMART_PTR_TRANSFER_REJECTED(key) if it is defined.
+ * - A copy that is never received stays in the table. memcpy_transfer_dump lists
+ *   them with their sequence numbers; the oldest entries are the orphans.
+ *
+ * Each operation touches a bounded number of slots inside a memcpy_critical_section
+ * (see memcpy_lock_policy.h), so it costs O(1) and is safe from interrupt handlers.
+ * When no slot is free the transfer is counted as untracked, and as many unknown
+ * receives are then accepted instead of rejected.
+ *
+ * For untracked types (the default) every hook is an empty inline function, and
+ * without any tracked type the table is not even linked in.
+ */
+#ifndef MEMCPY_SMART_PTR_TRACK_TRANSFERS
+#define MEMCPY_SMART_PTR_TRACK_TRANSFERS 0
+#endif
+
+// Slots of the side table (a power of two); each is two pointers and two counters
+#ifndef MEMCPY_SMART_PTR_TRACK_CAPACITY
+#define MEMCPY_SMART_PTR_TRACK_CAPACITY 64
+#endif
+
+// Slots probed per operation, which bounds its cost
+#ifndef MEMCPY_SMART_PTR_TRACK_PROBES
+#define MEMCPY_SMART_PTR_TRACK_PROBES 8
+#endif
+
+static_assert((MEMCPY_SMART_PTR_TRACK_CAPACITY & (MEMCPY_SMART_PTR_TRACK_CAPACITY - 1)) == 0,
+              "MEMCPY_SMART_PTR_TRACK_CAPACITY must be a power of two");
+static_assert(MEMCPY_SMART_PTR_TRACK_PROBES <= MEMCPY_SMART_PTR_TRACK_CAPACITY,
+              "MEMCPY_SMART_PTR_TRACK_PROBES cannot exceed the capacity");
+
+// An object with bitwise copies in flight. The key is the managed object (unique) or control block (shared).
+struct memcpy_transfer_record
+{
+    const void *key = nullptr;
+    uint32_t sequence = 0; // stamp of the latest send
+    uint32_t copies = 0;   // copies sent and not received yet
+};
+
+struct memcpy_transfer_summary
+{
+    uint32_t sequence = 0;  // stamp the next send will get
+    uint32_t tracked = 0;   // objects with copies in flight
+    uint32_t untracked = 0; // sends that found the table full and were not received yet
+    uint32_t rejected = 0;  // receives refused as duplicated or unknown
+};
+
+template <class T>
+struct memcpy_transfer_tracked : std::integral_constant<bool, MEMCPY_SMART_PTR_TRACK_TRANSFERS != 0>
+{
+};
+
+namespace memcpy_transfer_detail
+{
+    struct table
+    {
+        memcpy_transfer_record slots[MEMCPY_SMART_PTR_TRACK_CAPACITY];
+        memcpy_transfer_summary summary;
+    };
+
+    inline table &instance() noexcept
+    {
+        static table tracked;
+        return tracked;
+    }
+
+    // Marks a slot whose transfer completed: lookups probe past it, inserts reuse it
+    inline const void *tombstone() noexcept
+    {
+        static const char marker = 0;
+        return &marker;
+    }
+
+    inline std::size_t home(const void *key) noexcept
+    {
+        const uintptr_t bits = reinterpret_cast<uintptr_t>(key) >> 2; // objects are at least word aligned
+        return static_cast<std::size_t>(static_cast<uint32_t>(bits) * 2654435769u) & (MEMCPY_SMART_PTR_TRACK_CAPACITY - 1);
+    }
+
+    inline memcpy_transfer_record &slot(table &tracked, const void *key, std::size_t probe) noexcept
+    {
+        return tracked.slots[(home(key) + probe) & (MEMCPY_SMART_PTR_TRACK_CAPACITY - 1)];
+    }
+
+    inline void sent(const void *key) noexcept
+    {
+        if (key == nullptr)
+        {
+            return; // Empty pointers own nothing
+        }
+        memcpy_critical_section guard;
+        table &tracked = instance();
+        memcpy_transfer_record *free_slot = nullptr;
+        for (std::size_t probe = 0; probe < MEMCPY_SMART_PTR_TRACK_PROBES; probe++)
+        {
+            memcpy_transfer_record &record = slot(tracked, key, probe);
+            if (record.key == key)
+            {
+                record.copies++;
+                record.sequence = tracked.summary.sequence++;
+                return;
+            }
+            if (free_slot == nullptr && (record.key == nullptr || record.key == tombstone()))
+            {
+                free_slot = &record;
+            }
+            if (record.key == nullptr)
+            {
+                break; // 'key' would have been placed before the first empty slot
+            }
+        }
+        if (free_slot == nullptr)
+        {
+            tracked.summary.untracked++;
+            return;
+        }
+        free_slot->key = key;
+        free_slot->copies = 1;
+        free_slot->sequence = tracked.summary.sequence++;
+        tracked.summary.tracked++;
+    }
+
+    inline bool received(const void *key) noexcept
+    {
+        if (key == nullptr)
+        {
+            return true;
+        }
+        {
+            memcpy_critical_section guard;
+            table &tracked = instance();
+            for (std::size_t probe = 0; probe < MEMCPY_SMART_PTR_TRACK_PROBES; probe++)
+            {
+                memcpy_transfer_record &record = slot(tracked, key, probe);
+                if (record.key == key)
+                {
+                    if (--record.copies == 0)
+                    {
+                        record.key = tombstone();
+                        tracked.summary.tracked--;
+                    }
+                    return true;
+                }
+                if (record.key == nullptr)
+                {
+                    break;
+                }
+            }
+            if (tracked.summary.untracked > 0)
+            {
+                tracked.summary.untracked--; // Possibly the copy that found the table full
+                return true;
+            }
+            tracked.summary.rejected++;
+        }
+#ifdef MEMCPY_SMART_PTR_TRANSFER_REJECTED
+        MEMCPY_SMART_PTR_TRANSFER_REJECTED(key);
+#endif
+        return false;
+    }
+}
+
+// Hooks of the smart pointers for managed type T
+template <class T>
+struct memcpy_transfer_tracker
+{
+    static constexpr bool enabled = memcpy_transfer_tracked<T>::value;
+
+    /**
+     * Records a bitwise copy of 'key' about to be sent. Called before the copy, since
+     * the receiver may run first; if the copy fails the record is checked off again.
+     */
+    static void sent(const void *key) noexcept
+    {
+        if constexpr (enabled)
+        {
+            memcpy_transfer_detail::sent(key);
+        }
+    }
+
+    /**
+     * Checks off a received copy of 'key'. Returns false if no copy of it is in flight,
+     * in which case the receiver must drop the bits without releasing them.
+     */
+    static bool received(const void *key) noexcept
+    {
+        if constexpr (enabled)
+        {
+            return memcpy_transfer_detail::received(key);
+        }
+        return true;
+    }
+};
+
+/**
+ * Copies up to 'max_records' in-flight records into 'out' and returns how many were
+ * written. Compare their sequence with memcpy_transfer_report().sequence: a copy
+ * that has been in flight for many sends is likely lost. Each slot is read under
+ * its own critical section, so the dump does not hold off interrupts for long.
+ */
+inline std::size_t memcpy_transfer_dump(memcpy_transfer_record *out, std::size_t max_records) noexcept
+{
+    using namespace memcpy_transfer_detail;
+    std::size_t written = 0;
+    table &tracked = instance();
+    for (std::size_t i = 0; i < MEMCPY_SMART_PTR_TRACK_CAPACITY && written < max_records; i++)
+    {
+        memcpy_critical_section guard;
+        const memcpy_transfer_record &record = tracked.slots[i];
+        if (record.key != nullptr && record.key != tombstone())
+        {
+            out[written++] = record;
+        }
+    }
+    return written;
+}
+
+// Counters of the tracker (all zero while no tracked type transferred anything)
+inline memcpy_transfer_summary memcpy_transfer_report() noexcept
+{
+    memcpy_critical_section guard;
+    return memcpy_transfer_detail::instance().summary;
+}
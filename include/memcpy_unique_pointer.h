@@ -1,24 +1,232 @@
+#pragma once
+
 #include <type_traits>
+#include <cstddef>
+#include <cstdint>
 #include <cstring> // For memcpy
+#include <utility>
+
+#include "memcpy_construct.h"
+#include "memcpy_span.h"
+#include "memcpy_stats.h"
+#include "memcpy_transfer_tracker.h"
+#include "memcpy_relocate.h"
+
+// Default deleter: releases the object with delete (class-specific operator delete included).
+template <class T>
+struct memcpy_default_delete
+{
+    void operator()(T *ptr) const noexcept { delete ptr; }
+};
+
+// Arrays (memcpy_unique_ptr<T[]>) are released with delete[].
+template <class T>
+struct memcpy_default_delete<T[]>
+{
+    void operator()(T *ptr) const noexcept { delete[] ptr; }
+};
+
+/**
+ * Deleter for memory from a C allocator, e.g. memcpy_free_delete<Frame, vPortFree>.
+ * Runs the destructor and hands the storage back to Free. Being stateless, it adds
+ * nothing to sizeof(memcpy_unique_ptr).
+ */
+template <class T, void (*Free)(void *)>
+struct memcpy_free_delete
+{
+    void operator()(T *ptr) const noexcept
+    {
+        ptr->~T();
+        Free(ptr);
+    }
+};
+
+// Deleter that releases nothing, for objects whose storage is owned elsewhere (a static buffer, an arena).
+template <class T>
+struct memcpy_noop_delete
+{
+    void operator()(T *) const noexcept {}
+};
+
+/**
+ * True for deleters that do nothing at all. A memcpy_unique_ptr with such a deleter
+ * has its release dropped at compile time (see memcpy_unique_ptr_storage).
+ * Specialize it for a custom deleter only if its call is really empty.
+ */
+template <class Deleter>
+struct memcpy_is_noop_deleter : std::false_type
+{
+};
+
+template <class T>
+struct memcpy_is_noop_deleter<memcpy_noop_delete<T>> : std::true_type
+{
+};
+
+/**
+ * Holds the deleter of a memcpy_unique_ptr.
+ * An empty deleter is stored as a base class so it takes no space (empty base
+ * optimization) and the pointer stays exactly one word in a queue item.
+ */
+template <class Deleter, bool = std::is_empty<Deleter>::value && !std::is_final<Deleter>::value>
+class memcpy_unique_ptr_deleter_holder : private Deleter
+{
+protected:
+    memcpy_unique_ptr_deleter_holder() = default;
+    explicit memcpy_unique_ptr_deleter_holder(const Deleter &deleter) : Deleter(deleter) {}
+
+    Deleter &deleter() noexcept { return *this; }
+    const Deleter &deleter() const noexcept { return *this; }
+};
+
+// Stateful (or final) deleter: stored as a member.
+template <class Deleter>
+class memcpy_unique_ptr_deleter_holder<Deleter, false>
+{
+protected:
+    memcpy_unique_ptr_deleter_holder() = default;
+    explicit memcpy_unique_ptr_deleter_holder(const Deleter &deleter) : held(deleter) {}
+
+    Deleter &deleter() noexcept { return held; }
+    const Deleter &deleter() const noexcept { return held; }
+
+private:
+    Deleter held{};
+};
+
+/**
+ * Element count of a memcpy_unique_ptr<T[]>. It is stored next to the pointer so it
+ * travels with it through bitwise copies; a single object needs none and the empty
+ * base takes no space.
+ */
+template <class T, bool = std::is_array<T>::value>
+class memcpy_unique_ptr_length
+{
+protected:
+    memcpy_unique_ptr_length() = default;
+    explicit memcpy_unique_ptr_length(std::size_t) noexcept {}
+
+    static constexpr std::size_t length() noexcept { return 1; }
+    void set_length(std::size_t) noexcept {}
+};
+
+template <class T>
+class memcpy_unique_ptr_length<T, true>
+{
+protected:
+    memcpy_unique_ptr_length() = default;
+    explicit memcpy_unique_ptr_length(std::size_t length) noexcept : held(length) {}
+
+    std::size_t length() const noexcept { return held; }
+    void set_length(std::size_t length) noexcept { held = length; }
+
+private:
+    std::size_t held = 0;
+};
+
+/**
+ * Holds the managed pointer of a memcpy_unique_ptr and releases it on destruction.
+ * With a no-op deleter (and no instrumentation of T) there is nothing to release:
+ * the destructor is trivial, so arrays, rings and queues of such pointers skip it.
+ */
+template <class T, class Deleter,
+          bool = memcpy_is_noop_deleter<Deleter>::value && !memcpy_stats<std::remove_extent_t<T>>::enabled>
+class memcpy_unique_ptr_storage : protected memcpy_unique_ptr_deleter_holder<Deleter>
+{
+    using stats = memcpy_stats<std::remove_extent_t<T>>;
+
+protected:
+    memcpy_unique_ptr_storage() = default;
+    explicit memcpy_unique_ptr_storage(std::remove_extent_t<T> *ptr) noexcept : ptr(ptr) {}
+    memcpy_unique_ptr_storage(std::remove_extent_t<T> *ptr, const Deleter &deleter) noexcept
+        : memcpy_unique_ptr_deleter_holder<Deleter>(deleter), ptr(ptr) {}
+
+    ~memcpy_unique_ptr_storage() { destroy(); }
+
+    // Hands the managed object (if any) to the deleter
+    void destroy() noexcept
+    {
+        if (ptr != nullptr)
+        {
+            this->deleter()(ptr);
+            stats::on_free();
+        }
+    }
+
+    std::remove_extent_t<T> *ptr = nullptr;
+};
+
+// No-op deleter: trivially destructible
+template <class T, class Deleter>
+class memcpy_unique_ptr_storage<T, Deleter, true> : protected memcpy_unique_ptr_deleter_holder<Deleter>
+{
+protected:
+    memcpy_unique_ptr_storage() = default;
+    explicit memcpy_unique_ptr_storage(std::remove_extent_t<T> *ptr) noexcept : ptr(ptr) {}
+    memcpy_unique_ptr_storage(std::remove_extent_t<T> *ptr, const Deleter &deleter) noexcept
+        : memcpy_unique_ptr_deleter_holder<Deleter>(deleter), ptr(ptr) {}
+
+    void destroy() noexcept {}
+
+    std::remove_extent_t<T> *ptr = nullptr;
+};
 
 /**
  * A unique-ownership smart pointer designed for bitwise transfer compatibility.
  * * Unlike std::unique_ptr, this class provides specific hooks (memcpy_send/receive)
  * to allow the internal pointer state to be moved through C-style APIs like 
  * RTOS queues or circular buffers while maintaining RAII safety.
+ *
+ * The Deleter decides how the object is released (pool slot, DMA buffer, pvPortMalloc, ...).
+ * Its state travels with the pointer through bitwise copies, so it must be trivially copyable.
+ *
+ * memcpy_unique_ptr<T[]> manages an array released with delete[] and also carries
+ * its element count (see size() and span()).
  */
-template <class T>
-class memcpy_unique_ptr
+template <class T, class Deleter = memcpy_default_delete<T>>
+class memcpy_unique_ptr : private memcpy_unique_ptr_storage<T, Deleter>, private memcpy_unique_ptr_length<T>
 {
+    static_assert(std::is_trivially_copyable<Deleter>::value,
+                  "memcpy_unique_ptr deleters are copied bitwise and must be trivially copyable");
+    static_assert(std::extent<T>::value == 0, "memcpy_unique_ptr<T[N]> is not supported, use memcpy_unique_ptr<T[]>");
+
+    using storage = memcpy_unique_ptr_storage<T, Deleter>;
+    using length_holder = memcpy_unique_ptr_length<T>;
+    using stats = memcpy_stats<std::remove_extent_t<T>>;
+    using tracker = memcpy_transfer_tracker<std::remove_extent_t<T>>;
+
 public:
+    using element_type = std::remove_extent_t<T>;
+
     // Default constructor: creates an empty manager
-    memcpy_unique_ptr() noexcept : ptr(nullptr) 
+    memcpy_unique_ptr() noexcept : storage(nullptr)
     {
     }
 
     // Explicit constructor: takes ownership of a raw pointer
-    explicit memcpy_unique_ptr(T *ptr) noexcept : ptr(ptr)
+    explicit memcpy_unique_ptr(element_type *ptr) noexcept : storage(ptr)
+    {
+        track_allocation();
+    }
+
+    // Takes ownership of a raw pointer that must be released through 'deleter'
+    memcpy_unique_ptr(element_type *ptr, const Deleter &deleter) noexcept : storage(ptr, deleter)
+    {
+        track_allocation();
+    }
+
+    // Takes ownership of an array of 'length' elements
+    template <class U = T, typename std::enable_if<std::is_array<U>::value, int>::type = 0>
+    memcpy_unique_ptr(element_type *ptr, std::size_t length) noexcept : storage(ptr), length_holder(length)
     {
+        track_allocation();
+    }
+
+    template <class U = T, typename std::enable_if<std::is_array<U>::value, int>::type = 0>
+    memcpy_unique_ptr(element_type *ptr, std::size_t length, const Deleter &deleter) noexcept
+        : storage(ptr, deleter), length_holder(length)
+    {
+        track_allocation();
     }
 
     // --- Ownership Rules ---
@@ -27,9 +235,9 @@ public:
     memcpy_unique_ptr &operator=(const memcpy_unique_ptr &obj) = delete; 
 
     // Move constructor: Transfers ownership from a dying object to this one.
-    memcpy_unique_ptr(memcpy_unique_ptr &&dyingObj) noexcept 
+    memcpy_unique_ptr(memcpy_unique_ptr &&dyingObj) noexcept
+        : storage(dyingObj.ptr, dyingObj.deleter()), length_holder(dyingObj.length())
     {
-        this->ptr = dyingObj.ptr;
         dyingObj.ptr = nullptr; // Dying object is now empty
     }
 
@@ -38,29 +246,41 @@ public:
     {
         if (this != &dyingObj) // Protect against self-assignment
         {
-            delete ptr; // Release existing resource
+            destroy(); // Release existing resource
             ptr = dyingObj.ptr;
+            this->deleter() = dyingObj.deleter();
+            this->set_length(dyingObj.length());
             dyingObj.ptr = nullptr;
         }
         return *this;
     }
 
     // --- Pointer Accessors ---
-    T *operator->() { return this->ptr; }
-    T &operator*()  { return *(this->ptr); }
-    T *get()        { return ptr; }
+    element_type *operator->() { return this->ptr; }
+    element_type &operator*()  { return *(this->ptr); }
+    element_type *get() const noexcept { return ptr; }
 
-    // Destructor: Automatically deletes the managed object
-    ~memcpy_unique_ptr() 
-    {
-        delete ptr;
-    }
+    // --- Array Accessors (memcpy_unique_ptr<T[]> only) ---
+    template <class U = T, typename std::enable_if<std::is_array<U>::value, int>::type = 0>
+    element_type &operator[](std::size_t index) { return ptr[index]; }
+
+    // Number of elements (0 when empty)
+    template <class U = T, typename std::enable_if<std::is_array<U>::value, int>::type = 0>
+    std::size_t size() const noexcept { return ptr == nullptr ? 0 : this->length(); }
+
+    template <class U = T, typename std::enable_if<std::is_array<U>::value, int>::type = 0>
+    memcpy_span<element_type> span() noexcept { return memcpy_span<element_type>{ptr, size()}; }
+
+    Deleter &get_deleter() noexcept { return this->deleter(); }
+    const Deleter &get_deleter() const noexcept { return this->deleter(); }
+
+    // No destructor of its own: memcpy_unique_ptr_storage releases the managed object
 
     // --- C-API Bridge Interface (SFINAE Guarded) ---
 
     // Signature Requirement: bool func(void* dest, const memcpy_unique_ptr* src)
     template <typename _Function>
-    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_unique_ptr<T> *const>;
+    constexpr static bool is_memcpy_send_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_unique_ptr *const>;
 
     /**
      * Prepares the pointer for a bitwise send (e.g., xQueueSend).
@@ -72,56 +292,216 @@ public:
     memcpy_send(void *const dest, _Function copy_fn_src)
     {
         bool success = false;
+        tracker::sent(ptr); // Before the copy: the receiver may claim it right away
         if (copy_fn_src(dest, this))
         {
             ptr = nullptr; // Successfully "moved" into the buffer
+            stats::on_send();
             success = true;
         }
+        else
+        {
+            tracker::received(ptr); // Not sent after all
+        }
         return success;
     }
 
     // Signature Requirement: bool func(memcpy_unique_ptr* dest, const void* src)
     template <typename _Function>
-    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_unique_ptr<T> *const, const void *const>;
+    constexpr static bool is_memcpy_receive_signature = std::is_invocable_r_v<bool, _Function, memcpy_unique_ptr *const, const void *const>;
 
     /**
      * Claims ownership from a bitwise source (e.g., xQueueReceive).
-     * Uses a temporary buffer to safely receive the bits before updating 'this'.
+     * If 'this' is empty the copy function writes straight into it (one copy per hop);
+     * otherwise a temporary buffer receives the bits before the current object is released.
+     * On failure the copy function must leave the destination untouched, as xQueueReceive does.
      */
     template <typename _Function>
     typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type 
     memcpy_receive(const void *const src, _Function copy_fn_dest)
     {
-        uint8_t buffer[sizeof(memcpy_unique_ptr<T>)];
+        if (ptr == nullptr)
+        {
+            return copy_fn_dest(this, src) && claim(this); // Nothing to release: receive in place
+        }
+
+        uint8_t buffer[sizeof(memcpy_unique_ptr)];
         bool success = false;
 
         // Perform the bitwise copy into a temporary buffer first
-        if (copy_fn_dest(reinterpret_cast<memcpy_unique_ptr<T> *>(buffer), src))
+        if (copy_fn_dest(reinterpret_cast<memcpy_unique_ptr *>(buffer), src) &&
+            claim(reinterpret_cast<memcpy_unique_ptr *>(buffer)))
         {
-            delete ptr; // Clean up current data before accepting new ownership
+            destroy(); // Clean up current data before accepting new ownership
 
-            // Bitwise move: The object in the buffer is now managed by 'this'
-            memcpy(this, buffer, sizeof(memcpy_unique_ptr<T>));
+            // Bitwise move: The object (and its deleter) in the buffer is now managed by 'this'
+            memcpy(static_cast<void *>(this), buffer, sizeof(memcpy_unique_ptr));
             success = true;
         }
         return success;
     }
 
+    // --- Interrupt-safe C-API Bridge ---
+
+    /**
+     * memcpy_send for interrupt handlers (e.g. around xQueueSendFromISR).
+     * A unique pointer has no counter, so this is the copy plus one store: no
+     * allocation, no locks, no loops beyond those of the copy function itself.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_send_signature<_Function>, bool>::type
+    memcpy_send_from_isr(void *const dest, _Function copy_fn_src) noexcept
+    {
+        tracker::sent(ptr);
+        const bool success = copy_fn_src(dest, this);
+        if (success)
+        {
+            ptr = nullptr;
+            stats::on_send();
+        }
+        else
+        {
+            tracker::received(ptr);
+        }
+        return success;
+    }
+
+    /**
+     * memcpy_receive for interrupt handlers (e.g. around xQueueReceiveFromISR).
+     * Releasing a current object could free memory, which an ISR must not do, so
+     * the receive only happens into an empty pointer; otherwise it returns false
+     * without calling the copy function.
+     */
+    template <typename _Function>
+    typename std::enable_if<is_memcpy_receive_signature<_Function>, bool>::type
+    memcpy_receive_from_isr(const void *const src, _Function copy_fn_dest) noexcept
+    {
+        return ptr == nullptr && copy_fn_dest(this, src) && claim(this);
+    }
+
+    /**
+     * Claims ownership directly from addressable storage holding a sent pointer
+     * (e.g. a slot of a ring buffer in RAM). Costs a single bitwise copy; the
+     * source bytes must not be received again afterwards.
+     */
+    void memcpy_adopt(const void *const src) noexcept
+    {
+        destroy();
+        memcpy(static_cast<void *>(this), src, sizeof(memcpy_unique_ptr));
+        claim(this);
+    }
+
+    // --- Batched C-API Bridge ---
+
+    // Signature Requirement: bool func(void* dest, const memcpy_unique_ptr* src, size_t count)
+    template <typename _Function>
+    constexpr static bool is_memcpy_send_batch_signature = std::is_invocable_r_v<bool, _Function, void *const, const memcpy_unique_ptr *const, const std::size_t>;
+
+    /**
+     * Sends 'count' contiguous pointers with a single call to the copy function
+     * (e.g. one ring-buffer write of count * sizeof(memcpy_unique_ptr) bytes).
+     * Ownership of all of them is relinquished together, and only if the copy succeeds.
+     */
+    template <typename _Function>
+    static typename std::enable_if<is_memcpy_send_batch_signature<_Function>, bool>::type
+    memcpy_send_batch(memcpy_unique_ptr *const ptrs, const std::size_t count, void *const dest, _Function copy_fn_src)
+    {
+        bool success = false;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            tracker::sent(ptrs[i].ptr);
+        }
+        if (copy_fn_src(dest, ptrs, count))
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                ptrs[i].ptr = nullptr; // Every element now lives in the buffer
+            }
+            stats::on_send(static_cast<uint32_t>(count));
+            success = true;
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                tracker::received(ptrs[i].ptr);
+            }
+        }
+        return success;
+    }
+
+    template <std::size_t N, typename _Function>
+    static typename std::enable_if<is_memcpy_send_batch_signature<_Function>, bool>::type
+    memcpy_send_batch(memcpy_unique_ptr (&ptrs)[N], void *const dest, _Function copy_fn_src)
+    {
+        return memcpy_send_batch(ptrs, N, dest, copy_fn_src);
+    }
+
+    // Signature Requirement: bool func(memcpy_unique_ptr* dest, const void* src, size_t count)
+    template <typename _Function>
+    constexpr static bool is_memcpy_receive_batch_signature = std::is_invocable_r_v<bool, _Function, memcpy_unique_ptr *const, const void *const, const std::size_t>;
+
+    /**
+     * Claims 'count' contiguous pointers with a single call to the copy function.
+     * The destination objects are released first and the copy function then writes
+     * straight into them, so a batch does not need a temporary buffer. If the copy
+     * fails the destinations are left empty; the copy function must not write on failure.
+     */
+    template <typename _Function>
+    static typename std::enable_if<is_memcpy_receive_batch_signature<_Function>, bool>::type
+    memcpy_receive_batch(memcpy_unique_ptr *const ptrs, const std::size_t count, const void *const src, _Function copy_fn_dest)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            ptrs[i].destroy();
+            ptrs[i].ptr = nullptr;
+        }
+        const bool success = copy_fn_dest(ptrs, src, count);
+        if (success)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                claim(&ptrs[i]); // A rejected copy leaves its element empty
+            }
+        }
+        return success;
+    }
+
+    template <std::size_t N, typename _Function>
+    static typename std::enable_if<is_memcpy_receive_batch_signature<_Function>, bool>::type
+    memcpy_receive_batch(memcpy_unique_ptr (&ptrs)[N], const void *const src, _Function copy_fn_dest)
+    {
+        return memcpy_receive_batch(ptrs, N, src, copy_fn_dest);
+    }
+
     // --- Utility Functions ---
 
     // Releases ownership and returns the raw pointer (caller must delete it)
-    T *release()
+    element_type *release()
     {
-        T *temp = ptr;
+        element_type *temp = ptr;
+        if (temp != nullptr)
+        {
+            stats::on_free(); // No longer managed
+        }
         ptr = nullptr;
         return temp;
     }
 
     // Replaces the managed object with a new one
-    void reset(T *pt) noexcept
+    void reset(element_type *pt) noexcept
     {
-        delete ptr;
+        destroy();
         ptr = pt;
+        track_allocation();
+    }
+
+    // Replaces the managed array with a new one of 'length' elements
+    template <class U = T, typename std::enable_if<std::is_array<U>::value, int>::type = 0>
+    void reset(element_type *pt, std::size_t length) noexcept
+    {
+        reset(pt);
+        this->set_length(length);
     }
 
     // Contextual conversion to bool (check if ptr is not null)
@@ -131,16 +511,84 @@ public:
     }
 
 private:
-    T *ptr = nullptr;
+    using storage::ptr;
+    using storage::destroy;
+
+    // --- Instrumentation (see memcpy_stats.h; no code unless enabled) ---
+    void track_allocation() noexcept
+    {
+        if (ptr != nullptr)
+        {
+            stats::on_allocate();
+        }
+    }
+
+    // Accepts the bits just received into 'dest', or drops a duplicated copy (see memcpy_transfer_tracker.h)
+    static bool claim(memcpy_unique_ptr *const dest) noexcept
+    {
+        if (!tracker::received(dest->ptr))
+        {
+            dest->ptr = nullptr;
+            return false;
+        }
+        stats::on_receive();
+        return true;
+    }
 };
 
 /**
  * Factory function: Ensures the managed object is constructible with provided arguments.
  * Provides a cleaner syntax: auto p = make_memcpy_unique_ptr<MyClass>(args...);
+ * The arguments are forwarded to the constructor, or brace-initialize an aggregate
+ * (make_memcpy_unique_ptr<Sample>(channel, value)).
+ * For a T derived from memcpy_pool_allocated an exhausted pool yields an empty pointer.
  */
 template <typename T, typename... ParaTypes>
-typename std::enable_if<std::is_constructible<T, ParaTypes...>::value, memcpy_unique_ptr<T>>::type
+typename std::enable_if<memcpy_is_constructible<T, ParaTypes...>::value, memcpy_unique_ptr<T>>::type
 make_memcpy_unique_ptr(ParaTypes &&...paras)
 {
-    return memcpy_unique_ptr<T>{new T(std::forward<ParaTypes...>(paras...))};
-}
\ No newline at end of file
+    return memcpy_unique_ptr<T>{memcpy_new<T>(std::forward<ParaTypes>(paras)...)};
+}
+
+/**
+ * Same as make_memcpy_unique_ptr<T>(), but the object is default-initialized: the
+ * trivial members of a large frame that will be filled in anyway are not zeroed.
+ */
+template <typename T>
+typename std::enable_if<!std::is_array<T>::value && std::is_default_constructible<T>::value, memcpy_unique_ptr<T>>::type
+make_memcpy_unique_ptr_for_overwrite()
+{
+    return memcpy_unique_ptr<T>{new T};
+}
+
+/**
+ * Factory function for arrays: auto samples = make_memcpy_unique_ptr<int16_t[]>(n);
+ * The 'length' elements are value-initialized (zeroed for arithmetic types).
+ */
+template <typename T>
+typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0, memcpy_unique_ptr<T>>::type
+make_memcpy_unique_ptr(std::size_t length)
+{
+    return memcpy_unique_ptr<T>{new std::remove_extent_t<T>[length](), length};
+}
+
+/**
+ * Same as make_memcpy_unique_ptr<T[]>, but the elements are default-initialized:
+ * buffers of arithmetic types are left uninitialized, so a DMA-sized buffer that
+ * will be overwritten anyway costs no zeroing.
+ */
+template <typename T>
+typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0, memcpy_unique_ptr<T>>::type
+make_memcpy_unique_ptr_for_overwrite(std::size_t length)
+{
+    return memcpy_unique_ptr<T>{new std::remove_extent_t<T>[length], length};
+}
+
+// The deleter is trivially copyable and nothing points into the object: a bitwise move is a move.
+template <class T, class Deleter>
+struct memcpy_is_trivially_relocatable<memcpy_unique_ptr<T, Deleter>> : std::true_type
+{
+};
+
+static_assert(sizeof(memcpy_unique_ptr<int>) == sizeof(int *), "memcpy_unique_ptr must stay one pointer wide");
+static_assert(sizeof(memcpy_unique_ptr<int[]>) == sizeof(int *) + sizeof(std::size_t), "memcpy_unique_ptr<T[]> is a pointer and a length");
@@ -0,0 +1,296 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <new>
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/sync.h"
+
+#include "memcpy_rp2040.h"
+#include "memcpy_shared_pointer.h"
+#include "memcpy_unique_pointer.h"
+
+/**
+ * Cycle-count benchmarks for memcpy_unique_ptr / memcpy_shared_ptr on the RP2040.
+ *
+ * Cortex-M0+ has no DWT cycle counter, so every operation is timed with SysTick
+ * running from the processor clock (24-bit, one tick per cycle). Build with
+ * MEMCPY_BENCH_USE_TIMER to time with time_us_64() instead; the result is then
+ * converted to cycles through clk_sys and is only meaningful for long runs.
+ *
+ * Results are printed over stdio every few seconds so a terminal attached late
+ * still sees them.
+ */
+
+namespace
+{
+    constexpr uint32_t iterations = 256;
+
+    template <std::size_t Size>
+    struct payload
+    {
+        explicit payload(uint32_t seed) { memset(bytes, static_cast<int>(seed), sizeof(bytes)); }
+        uint8_t bytes[Size];
+    };
+
+#if defined(MEMCPY_BENCH_USE_TIMER)
+    using stamp_t = uint64_t;
+
+    void timer_init() {}
+
+    inline stamp_t now() { return time_us_64(); }
+
+    inline uint32_t elapsed_cycles(stamp_t start, stamp_t end)
+    {
+        return static_cast<uint32_t>((end - start) * (clock_get_hz(clk_sys) / 1000000u));
+    }
+#else
+    using stamp_t = uint32_t;
+
+    void timer_init()
+    {
+        systick_hw->rvr = 0x00FFFFFF; // Full 24-bit reload
+        systick_hw->cvr = 0;
+        systick_hw->csr = 0x5; // ENABLE | CLKSOURCE (processor clock), no interrupt
+    }
+
+    inline stamp_t now() { return systick_hw->cvr; }
+
+    // SysTick counts down; a single measurement must stay below 2^24 cycles.
+    inline uint32_t elapsed_cycles(stamp_t start, stamp_t end) { return (start - end) & 0x00FFFFFF; }
+#endif
+
+    // Cost of reading the timer twice, subtracted from every sample
+    uint32_t timer_overhead = 0;
+
+    struct sample
+    {
+        uint32_t total = 0;
+        uint32_t count = 0;
+
+        void add(stamp_t start, stamp_t end)
+        {
+            const uint32_t cycles = elapsed_cycles(start, end);
+            total += cycles > timer_overhead ? cycles - timer_overhead : 0;
+            count++;
+        }
+
+        uint32_t average() const { return count ? total / count : 0; }
+    };
+
+    void calibrate()
+    {
+        uint32_t best = UINT32_MAX;
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            const stamp_t start = now();
+            const stamp_t end = now();
+            const uint32_t cycles = elapsed_cycles(start, end);
+            best = cycles < best ? cycles : best;
+        }
+        timer_overhead = best;
+    }
+
+    template <class Ptr>
+    bool copy_to_buffer(void *const dest, const Ptr *const src)
+    {
+        memcpy(dest, static_cast<const void *>(src), sizeof(Ptr));
+        return true;
+    }
+
+    template <class Ptr>
+    bool copy_from_buffer(Ptr *const dest, const void *const src)
+    {
+        memcpy(static_cast<void *>(dest), src, sizeof(Ptr));
+        return true;
+    }
+
+    // --- Cross-core hand-off: core 1 receives every pointer and sends it straight back ---
+
+    constexpr uint32_t max_words = 4;
+
+    enum class echo_kind : uint32_t
+    {
+        unique_4,
+        unique_64,
+        unique_256,
+        shared_4,
+        shared_64,
+        shared_256,
+    };
+
+    template <class Ptr>
+    void fifo_send(Ptr &ptr)
+    {
+        static_assert(sizeof(Ptr) <= max_words * sizeof(uint32_t), "pointer does not fit the hand-off frame");
+        uint32_t words[max_words] = {};
+        ptr.memcpy_send(words, copy_to_buffer<Ptr>);
+        for (uint32_t i = 0; i < (sizeof(Ptr) + 3) / 4; i++)
+        {
+            multicore_fifo_push_blocking(words[i]);
+        }
+    }
+
+    template <class Ptr>
+    void fifo_receive(Ptr &ptr)
+    {
+        uint32_t words[max_words];
+        for (uint32_t i = 0; i < (sizeof(Ptr) + 3) / 4; i++)
+        {
+            words[i] = multicore_fifo_pop_blocking();
+        }
+        ptr.memcpy_receive(words, copy_from_buffer<Ptr>);
+    }
+
+    template <class Ptr>
+    void echo_one()
+    {
+        uint32_t words[max_words] = {};
+        {
+            // Scoped so the local copy is released before core 0 can touch the count again
+            Ptr local;
+            fifo_receive(local);
+            local.memcpy_send(words, copy_to_buffer<Ptr>);
+        }
+        for (uint32_t i = 0; i < (sizeof(Ptr) + 3) / 4; i++)
+        {
+            multicore_fifo_push_blocking(words[i]);
+        }
+    }
+
+    void core1_echo()
+    {
+        for (;;)
+        {
+            switch (static_cast<echo_kind>(multicore_fifo_pop_blocking()))
+            {
+            case echo_kind::unique_4:
+                echo_one<memcpy_unique_ptr<payload<4>>>();
+                break;
+            case echo_kind::unique_64:
+                echo_one<memcpy_unique_ptr<payload<64>>>();
+                break;
+            case echo_kind::unique_256:
+                echo_one<memcpy_unique_ptr<payload<256>>>();
+                break;
+            case echo_kind::shared_4:
+                echo_one<memcpy_multicore_shared_ptr<payload<4>>>();
+                break;
+            case echo_kind::shared_64:
+                echo_one<memcpy_multicore_shared_ptr<payload<64>>>();
+                break;
+            case echo_kind::shared_256:
+                echo_one<memcpy_multicore_shared_ptr<payload<256>>>();
+                break;
+            }
+        }
+    }
+
+    template <class Ptr>
+    struct make_fn;
+
+    template <class T, class Deleter>
+    struct make_fn<memcpy_unique_ptr<T, Deleter>>
+    {
+        static memcpy_unique_ptr<T, Deleter> make() { return make_memcpy_unique_ptr<T>(0xA5u); }
+    };
+
+    // Both cores touch the count during the hand-off, so the shared pointers count under the hardware spinlock
+    template <class T>
+    struct make_fn<memcpy_multicore_shared_ptr<T>>
+    {
+        static memcpy_multicore_shared_ptr<T> make() { return make_memcpy_multicore_shared_ptr<T>(0xA5u); }
+    };
+
+    template <class Ptr>
+    void run(const char *name, std::size_t payload_size, std::size_t heap_bytes, echo_kind kind)
+    {
+        sample make, destroy, send, receive, hand_off;
+
+        alignas(Ptr) unsigned char storage[sizeof(Ptr)];
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            stamp_t start = now();
+            Ptr *made = new (storage) Ptr(make_fn<Ptr>::make());
+            stamp_t end = now();
+            make.add(start, end);
+
+            start = now();
+            made->~Ptr();
+            end = now();
+            destroy.add(start, end);
+        }
+
+        Ptr ptr = make_fn<Ptr>::make();
+        alignas(Ptr) unsigned char buffer[sizeof(Ptr)];
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            stamp_t start = now();
+            ptr.memcpy_send(buffer, copy_to_buffer<Ptr>);
+            stamp_t end = now();
+            send.add(start, end);
+
+            start = now();
+            ptr.memcpy_receive(buffer, copy_from_buffer<Ptr>);
+            end = now();
+            receive.add(start, end);
+        }
+
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            const stamp_t start = now();
+            multicore_fifo_push_blocking(static_cast<uint32_t>(kind));
+            fifo_send(ptr);
+            fifo_receive(ptr);
+            const stamp_t end = now();
+            hand_off.add(start, end);
+        }
+
+        printf("%-28s %5u | %6lu %6lu | %6lu %6lu | %8lu | %3u %5u\n",
+               name, static_cast<unsigned>(payload_size),
+               static_cast<unsigned long>(make.average()), static_cast<unsigned long>(destroy.average()),
+               static_cast<unsigned long>(send.average()), static_cast<unsigned long>(receive.average()),
+               static_cast<unsigned long>(hand_off.average()),
+               static_cast<unsigned>(sizeof(Ptr)), static_cast<unsigned>(heap_bytes));
+    }
+
+    void run_all()
+    {
+        printf("\nmemcpy_smart_ptr cycle counts (clk_sys %lu Hz, %lu iterations, timer overhead %lu)\n",
+               static_cast<unsigned long>(clock_get_hz(clk_sys)), static_cast<unsigned long>(iterations),
+               static_cast<unsigned long>(timer_overhead));
+        printf("%-28s %5s | %6s %6s | %6s %6s | %8s | %3s %5s\n",
+               "pointer", "bytes", "make", "free", "send", "recv", "hand-off", "ptr", "heap");
+
+        run<memcpy_unique_ptr<payload<4>>>("memcpy_unique_ptr", 4, sizeof(payload<4>), echo_kind::unique_4);
+        run<memcpy_unique_ptr<payload<64>>>("memcpy_unique_ptr", 64, sizeof(payload<64>), echo_kind::unique_64);
+        run<memcpy_unique_ptr<payload<256>>>("memcpy_unique_ptr", 256, sizeof(payload<256>), echo_kind::unique_256);
+        run<memcpy_multicore_shared_ptr<payload<4>>>("memcpy_multicore_shared_ptr", 4,
+                                                     sizeof(memcpy_shared_ptr_control_block_inplace<payload<4>>), echo_kind::shared_4);
+        run<memcpy_multicore_shared_ptr<payload<64>>>("memcpy_multicore_shared_ptr", 64,
+                                                      sizeof(memcpy_shared_ptr_control_block_inplace<payload<64>>), echo_kind::shared_64);
+        run<memcpy_multicore_shared_ptr<payload<256>>>("memcpy_multicore_shared_ptr", 256,
+                                                       sizeof(memcpy_shared_ptr_control_block_inplace<payload<256>>), echo_kind::shared_256);
+
+        printf("make/free: factory and destructor; send/recv: memcpy_send / memcpy_receive into a local buffer;\n"
+               "hand-off: core 0 -> SIO FIFO -> core 1 -> SIO FIFO -> core 0 round trip; ptr/heap: RAM bytes.\n"
+               "Flash per instantiation: see memcpy_smart_ptr_pico_bench.sizes.txt next to the .elf.\n");
+    }
+}
+
+int main()
+{
+    stdio_init_all();
+    timer_init();
+    calibrate();
+    multicore_launch_core1(core1_echo);
+
+    for (;;)
+    {
+        run_all();
+        sleep_ms(5000);
+    }
+}
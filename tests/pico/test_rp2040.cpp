@@ -0,0 +1,95 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_rp2040.h"
+
+#include "pico/multicore.h"
+
+/**
+ * On-target checks of the SIO FIFO transport: core1 takes every pointer it is
+ * handed, touches the object and hands it straight back. After a shared round
+ * trip it also pushes echo_released once its own owner is gone.
+ */
+namespace
+{
+    struct Frame
+    {
+        uint32_t sequence;
+    };
+
+    enum class echo_kind : uint32_t
+    {
+        unique,
+        shared
+    };
+
+    constexpr uint32_t echo_released = 0xecu;
+
+    void core1_echo()
+    {
+        for (;;)
+        {
+            if (static_cast<echo_kind>(multicore_fifo_pop_blocking()) == echo_kind::unique)
+            {
+                memcpy_unique_ptr<Frame> frame;
+                memcpy_fifo_receive(frame);
+                frame->sequence++;
+                memcpy_fifo_send(frame);
+            }
+            else
+            {
+                {
+                    memcpy_multicore_shared_ptr<Frame> frame;
+                    memcpy_fifo_receive(frame);
+                    frame->sequence++;
+                    memcpy_fifo_send(frame);
+                }
+                multicore_fifo_push_blocking(echo_released);
+            }
+        }
+    }
+
+    void start_core1()
+    {
+        multicore_reset_core1();
+        multicore_launch_core1(core1_echo);
+    }
+}
+
+TEST_GROUP(MEMCPY_RP2040){};
+
+TEST(MEMCPY_RP2040, Unique_round_trip)
+{
+    start_core1();
+    memcpy_unique_ptr<Frame> frame = make_memcpy_unique_ptr<Frame>(1u);
+    Frame *const object = frame.get();
+
+    multicore_fifo_push_blocking(static_cast<uint32_t>(echo_kind::unique));
+    CHECK(memcpy_fifo_send(frame));
+    CHECK(frame.get() == nullptr);
+
+    CHECK(memcpy_fifo_receive_timeout_us(frame, 100000));
+    POINTERS_EQUAL(object, frame.get());
+    LONGS_EQUAL(2, frame->sequence);
+    multicore_reset_core1();
+}
+
+TEST(MEMCPY_RP2040, Shared_round_trip_counts_across_cores)
+{
+    start_core1();
+    memcpy_multicore_shared_ptr<Frame> frame = make_memcpy_multicore_shared_ptr<Frame>(7u);
+    memcpy_multicore_shared_ptr<Frame> back;
+
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        multicore_fifo_push_blocking(static_cast<uint32_t>(echo_kind::shared));
+        CHECK(memcpy_fifo_send(frame));
+        CHECK(memcpy_fifo_receive_timeout_us(back, 100000));
+
+        uint32_t released = 0;
+        CHECK(multicore_fifo_pop_timeout_us(100000, &released));
+        LONGS_EQUAL(echo_released, released);
+    }
+    POINTERS_EQUAL(frame.get(), back.get());
+    LONGS_EQUAL(2, frame.get_count()); // core1 dropped its owner before acknowledging
+    LONGS_EQUAL(107, frame->sequence);
+    multicore_reset_core1();
+}
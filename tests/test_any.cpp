@@ -0,0 +1,110 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_any_pointer.h"
+
+#include <cstring>
+#include <string>
+
+namespace
+{
+    struct Telemetry
+    {
+        int temperature;
+    };
+
+    struct Command
+    {
+        explicit Command(const char *name) : name(name) { live++; }
+        ~Command() { live--; }
+        std::string name;
+        static int live;
+    };
+
+    int Command::live = 0;
+
+    bool copy_out(void *const dest, const memcpy_any_unique_ptr *src)
+    {
+        memcpy(dest, src, sizeof(memcpy_any_unique_ptr));
+        return true;
+    }
+
+    bool copy_in(memcpy_any_unique_ptr *dest, const void *const src)
+    {
+        memcpy(static_cast<void *>(dest), src, sizeof(memcpy_any_unique_ptr));
+        return true;
+    }
+}
+
+TEST_GROUP(MEMCPY_ANY_UNIQUE_PTR){};
+
+TEST(MEMCPY_ANY_UNIQUE_PTR, Empty)
+{
+    memcpy_any_unique_ptr ptr;
+    CHECK_FALSE(ptr);
+    CHECK(ptr.get_if<Telemetry>() == nullptr);
+    CHECK(ptr.type_tag() == nullptr);
+}
+
+TEST(MEMCPY_ANY_UNIQUE_PTR, Get_if_matches_the_type_only)
+{
+    memcpy_any_unique_ptr ptr = make_memcpy_any_unique_ptr<Telemetry>(21);
+    CHECK(ptr.holds<Telemetry>());
+    LONGS_EQUAL(21, ptr.get_if<Telemetry>()->temperature);
+    CHECK(ptr.get_if<Command>() == nullptr);
+    CHECK(ptr.get_if<int>() == nullptr);
+}
+
+TEST(MEMCPY_ANY_UNIQUE_PTR, From_typed_pointer_and_back)
+{
+    memcpy_unique_ptr<Command> typed = make_memcpy_unique_ptr<Command>("start");
+    Command *const object = typed.get();
+    memcpy_any_unique_ptr any{std::move(typed)};
+    CHECK(typed.get() == nullptr);
+
+    memcpy_unique_ptr<Telemetry> wrong = any.take_if<Telemetry>();
+    CHECK(wrong.get() == nullptr);
+    CHECK(any);
+
+    memcpy_unique_ptr<Command> back = any.take_if<Command>();
+    POINTERS_EQUAL(object, back.get());
+    CHECK_FALSE(any);
+}
+
+TEST(MEMCPY_ANY_UNIQUE_PTR, Reset_runs_the_right_destructor)
+{
+    {
+        memcpy_any_unique_ptr ptr = make_memcpy_any_unique_ptr<Command>("stop");
+        LONGS_EQUAL(1, Command::live);
+    }
+    LONGS_EQUAL(0, Command::live);
+}
+
+TEST(MEMCPY_ANY_UNIQUE_PTR, One_queue_for_every_type)
+{
+    uint8_t queue[2][sizeof(memcpy_any_unique_ptr)];
+    memcpy_any_unique_ptr first = make_memcpy_any_unique_ptr<Telemetry>(30);
+    memcpy_any_unique_ptr second = make_memcpy_any_unique_ptr<Command>("reboot");
+    CHECK(first.memcpy_send(queue[0], copy_out));
+    CHECK(second.memcpy_send(queue[1], copy_out));
+    CHECK_FALSE(first);
+    LONGS_EQUAL(1, Command::live);
+
+    memcpy_any_unique_ptr msg;
+    CHECK(msg.memcpy_receive(queue[0], copy_in));
+    LONGS_EQUAL(30, msg.get_if<Telemetry>()->temperature);
+
+    CHECK(msg.memcpy_receive(queue[1], copy_in)); // Deletes the telemetry first
+    CHECK(msg.get_if<Telemetry>() == nullptr);
+    STRCMP_EQUAL("reboot", msg.get_if<Command>()->name.c_str());
+}
+
+TEST(MEMCPY_ANY_UNIQUE_PTR, Adopt_releases_the_current_payload)
+{
+    uint8_t slot[sizeof(memcpy_any_unique_ptr)];
+    memcpy_any_unique_ptr sent = make_memcpy_any_unique_ptr<Telemetry>(5);
+    CHECK(sent.memcpy_send(slot, copy_out));
+
+    memcpy_any_unique_ptr msg = make_memcpy_any_unique_ptr<Command>("old");
+    msg.memcpy_adopt(slot);
+    LONGS_EQUAL(0, Command::live);
+    LONGS_EQUAL(5, msg.get_if<Telemetry>()->temperature);
+}
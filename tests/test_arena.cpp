@@ -0,0 +1,126 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_arena.h"
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+    struct Event
+    {
+        int32_t code;
+        int32_t value;
+    };
+
+    struct Named
+    {
+        explicit Named(const char *name) : name(name) { live++; }
+        ~Named() { live--; }
+        std::string name;
+        static int live;
+    };
+
+    int Named::live = 0;
+
+    struct alignas(32) Aligned
+    {
+        int32_t word;
+    };
+
+    static_assert(std::is_trivially_destructible<memcpy_arena_unique_ptr<Event>>::value || memcpy_stats<Event>::enabled,
+                  "trivially destructible objects need no release");
+    static_assert(!std::is_trivially_destructible<memcpy_arena_unique_ptr<Named>>::value, "");
+    static_assert(sizeof(memcpy_arena_unique_ptr<Event>) == sizeof(void *), "arena pointers stay one word");
+}
+
+TEST_GROUP(MEMCPY_ARENA){};
+
+TEST(MEMCPY_ARENA, Objects_are_bump_allocated)
+{
+    memcpy_arena_buffer<256> arena;
+    memcpy_arena_unique_ptr<Event> first = make_memcpy_unique_ptr_in<Event>(arena, 1, 10);
+    memcpy_arena_unique_ptr<Event> second = make_memcpy_unique_ptr_in<Event>(arena, 2, 20);
+    CHECK(first);
+    CHECK(second);
+    LONGS_EQUAL(1, first->code);
+    LONGS_EQUAL(20, second->value);
+    CHECK(second.get() > first.get());
+    CHECK(arena.used() >= 2 * sizeof(Event));
+}
+
+TEST(MEMCPY_ARENA, Exhausted_arena_yields_empty_pointer)
+{
+    memcpy_arena_buffer<2 * sizeof(Event)> arena;
+    memcpy_arena_unique_ptr<Event> first = make_memcpy_unique_ptr_in<Event>(arena, 1, 0);
+    memcpy_arena_unique_ptr<Event> second = make_memcpy_unique_ptr_in<Event>(arena, 2, 0);
+    memcpy_arena_unique_ptr<Event> third = make_memcpy_unique_ptr_in<Event>(arena, 3, 0);
+    CHECK(first);
+    CHECK(second);
+    CHECK_FALSE(third);
+}
+
+TEST(MEMCPY_ARENA, Reset_reclaims_everything)
+{
+    memcpy_arena_buffer<64> arena;
+    void *first = nullptr;
+    {
+        memcpy_arena_unique_ptr<Event> event = make_memcpy_unique_ptr_in<Event>(arena, 1, 0);
+        first = event.get();
+    }
+    CHECK(arena.used() > 0);
+    arena.reset();
+    LONGS_EQUAL(0, arena.used());
+    memcpy_arena_unique_ptr<Event> next = make_memcpy_unique_ptr_in<Event>(arena, 2, 0);
+    POINTERS_EQUAL(first, next.get());
+}
+
+TEST(MEMCPY_ARENA, Session_resets_at_scope_end)
+{
+    memcpy_arena_buffer<128> arena;
+    {
+        memcpy_arena_session cycle{arena};
+        memcpy_arena_unique_ptr<Event> event = make_memcpy_unique_ptr_in<Event>(arena, 1, 0);
+        CHECK(event);
+        CHECK(arena.used() > 0);
+    }
+    LONGS_EQUAL(0, arena.used());
+}
+
+TEST(MEMCPY_ARENA, Destructor_runs_without_freeing)
+{
+    memcpy_arena_buffer<256> arena;
+    {
+        memcpy_arena_unique_ptr<Named> named = make_memcpy_unique_ptr_in<Named>(arena, "a long enough name to allocate");
+        LONGS_EQUAL(1, Named::live);
+    }
+    LONGS_EQUAL(0, Named::live);
+}
+
+TEST(MEMCPY_ARENA, Alignment_is_respected)
+{
+    memcpy_arena_buffer<256> arena;
+    memcpy_arena_unique_ptr<Event> event = make_memcpy_unique_ptr_in<Event>(arena, 1, 0);
+    memcpy_arena_unique_ptr<Aligned> aligned = make_memcpy_unique_ptr_in<Aligned>(arena);
+    CHECK(event);
+    CHECK(aligned);
+    LONGS_EQUAL(0, reinterpret_cast<uintptr_t>(aligned.get()) % alignof(Aligned));
+}
+
+TEST(MEMCPY_ARENA, Send_receive_within_the_cycle)
+{
+    memcpy_arena_buffer<128> arena;
+    memcpy_arena_unique_ptr<Event> event = make_memcpy_unique_ptr_in<Event>(arena, 7, 70);
+    Event *const object = event.get();
+
+    uint8_t queue[sizeof(memcpy_arena_unique_ptr<Event>)];
+    CHECK(event.memcpy_send(queue, [](void *const dest, const memcpy_arena_unique_ptr<Event> *src)
+                            { return memcpy(dest, src, sizeof(*src)) != nullptr; }));
+    CHECK_FALSE(event);
+
+    memcpy_arena_unique_ptr<Event> received;
+    CHECK(received.memcpy_receive(queue, [](memcpy_arena_unique_ptr<Event> *dest, const void *const src)
+                                  { return memcpy(static_cast<void *>(dest), src, sizeof(*dest)) != nullptr; }));
+    POINTERS_EQUAL(object, received.get());
+    LONGS_EQUAL(70, received->value);
+}
@@ -0,0 +1,102 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_unique_pointer.h"
+#include "memcpy_shared_pointer.h"
+
+#include <cstring>
+
+namespace
+{
+    struct Sample
+    {
+        Sample() { live++; }
+        ~Sample() { live--; }
+        int16_t value = 0;
+        static int live;
+    };
+
+    int Sample::live = 0;
+}
+
+TEST_GROUP(MEMCPY_ARRAY_PTR){};
+
+TEST(MEMCPY_ARRAY_PTR, Unique_array_deleted_with_delete_array)
+{
+    {
+        memcpy_unique_ptr<Sample[]> block{new Sample[4], 4};
+        LONGS_EQUAL(4, Sample::live);
+        LONGS_EQUAL(4, block.size());
+        block[2].value = 7;
+        LONGS_EQUAL(7, block.get()[2].value);
+    }
+    LONGS_EQUAL(0, Sample::live);
+}
+
+TEST(MEMCPY_ARRAY_PTR, Make_unique_array_is_zeroed)
+{
+    auto block = make_memcpy_unique_ptr<int16_t[]>(8);
+    LONGS_EQUAL(8, block.size());
+    for (int16_t sample : block.span())
+    {
+        LONGS_EQUAL(0, sample);
+    }
+}
+
+TEST(MEMCPY_ARRAY_PTR, Make_unique_array_for_overwrite)
+{
+    auto block = make_memcpy_unique_ptr_for_overwrite<uint8_t[]>(64);
+    CHECK(block);
+    LONGS_EQUAL(64, block.size());
+    memset(block.get(), 0xAB, block.span().size_bytes());
+    LONGS_EQUAL(0xAB, block[63]);
+}
+
+TEST(MEMCPY_ARRAY_PTR, Length_travels_with_the_pointer)
+{
+    using block_ptr = memcpy_unique_ptr<int32_t[]>;
+    LONGS_EQUAL(2 * sizeof(void *), sizeof(block_ptr));
+    LONGS_EQUAL(sizeof(void *), sizeof(memcpy_unique_ptr<int32_t>));
+
+    block_ptr sender = make_memcpy_unique_ptr<int32_t[]>(3);
+    sender[0] = 11;
+    uint8_t buffer[sizeof(block_ptr)];
+    sender.memcpy_send(buffer, [](void *dest, const block_ptr *src)
+                       { memcpy(dest, src, sizeof(block_ptr)); return true; });
+    LONGS_EQUAL(0, sender.size());
+
+    block_ptr receiver;
+    receiver.memcpy_receive(buffer, [](block_ptr *dest, const void *src)
+                            { memcpy(static_cast<void *>(dest), src, sizeof(block_ptr)); return true; });
+    LONGS_EQUAL(3, receiver.size());
+    LONGS_EQUAL(11, receiver[0]);
+
+    block_ptr moved{std::move(receiver)};
+    LONGS_EQUAL(3, moved.size());
+    LONGS_EQUAL(0, receiver.size());
+
+    moved.reset(new int32_t[5], 5);
+    LONGS_EQUAL(5, moved.size());
+}
+
+TEST(MEMCPY_ARRAY_PTR, Span_view)
+{
+    int32_t raw[4] = {1, 2, 3, 4};
+    memcpy_span<int32_t> all{raw};
+    LONGS_EQUAL(4, all.size());
+    memcpy_span<int32_t> tail = all.subspan(2, 2);
+    LONGS_EQUAL(3, tail[0]);
+    LONGS_EQUAL(4, *(tail.end() - 1));
+    CHECK_TRUE(memcpy_span<int32_t>{}.empty());
+}
+
+TEST(MEMCPY_ARRAY_PTR, Shared_array_deleted_with_delete_array)
+{
+    {
+        memcpy_shared_ptr<Sample[]> block1{new Sample[3]};
+        memcpy_shared_ptr<Sample[]> block2 = block1;
+        LONGS_EQUAL(2, block1.get_count());
+        block2[1].value = 5;
+        LONGS_EQUAL(5, block1[1].value);
+        LONGS_EQUAL(3, Sample::live);
+    }
+    LONGS_EQUAL(0, Sample::live);
+}
@@ -0,0 +1,120 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_atomic_shared_pointer.h"
+
+namespace
+{
+    struct Config
+    {
+        explicit Config(int version) : version(version) { live++; }
+        ~Config() { live--; }
+        int version;
+        static int live;
+    };
+
+    int Config::live = 0;
+
+    using config_ptr = memcpy_shared_ptr<Config>;
+
+    // Stores into 'slot' from its destructor, which only works if it is not released under the writer lock
+    struct Reentrant
+    {
+        explicit Reentrant(memcpy_atomic_shared_ptr<Reentrant> *slot) : slot(slot) {}
+        ~Reentrant()
+        {
+            if (slot != nullptr)
+            {
+                slot->store(make_memcpy_shared_ptr<Reentrant>(nullptr));
+            }
+        }
+        memcpy_atomic_shared_ptr<Reentrant> *slot;
+    };
+}
+
+TEST_GROUP(MEMCPY_ATOMIC_SHARED_PTR){};
+
+TEST(MEMCPY_ATOMIC_SHARED_PTR, Empty_by_default)
+{
+    memcpy_atomic_shared_ptr<Config> slot;
+    POINTERS_EQUAL(nullptr, slot.load().get());
+}
+
+TEST(MEMCPY_ATOMIC_SHARED_PTR, Load_shares_ownership)
+{
+    {
+        memcpy_atomic_shared_ptr<Config> slot{make_memcpy_shared_ptr<Config>(1)};
+        config_ptr reader = slot.load();
+        LONGS_EQUAL(1, reader->version);
+        LONGS_EQUAL(2, reader.get_count()); // The slot and the reader
+    }
+    LONGS_EQUAL(0, Config::live);
+}
+
+TEST(MEMCPY_ATOMIC_SHARED_PTR, Try_load_with_a_free_slot)
+{
+    memcpy_atomic_shared_ptr<Config> slot{make_memcpy_shared_ptr<Config>(2)};
+    config_ptr reader;
+    CHECK(slot.try_load(reader));
+    LONGS_EQUAL(2, reader->version);
+    LONGS_EQUAL(2, reader.get_count());
+}
+
+TEST(MEMCPY_ATOMIC_SHARED_PTR, Store_releases_replaced_value)
+{
+    memcpy_atomic_shared_ptr<Config> slot{make_memcpy_shared_ptr<Config>(1)};
+    config_ptr old = slot.load();
+
+    slot.store(make_memcpy_shared_ptr<Config>(2));
+    LONGS_EQUAL(2, slot.load()->version);
+    LONGS_EQUAL(1, old.get_count()); // The slot gave up its reference
+    LONGS_EQUAL(2, Config::live);
+
+    old = config_ptr{};
+    LONGS_EQUAL(1, Config::live);
+}
+
+TEST(MEMCPY_ATOMIC_SHARED_PTR, Exchange)
+{
+    memcpy_atomic_shared_ptr<Config> slot{make_memcpy_shared_ptr<Config>(1)};
+    config_ptr previous = slot.exchange(make_memcpy_shared_ptr<Config>(2));
+    LONGS_EQUAL(1, previous->version);
+    LONGS_EQUAL(1, previous.get_count());
+    LONGS_EQUAL(2, slot.load()->version);
+}
+
+TEST(MEMCPY_ATOMIC_SHARED_PTR, Compare_exchange)
+{
+    memcpy_atomic_shared_ptr<Config> slot{make_memcpy_shared_ptr<Config>(1)};
+    config_ptr expected = slot.load();
+
+    CHECK_TRUE(slot.compare_exchange(expected, make_memcpy_shared_ptr<Config>(2)));
+    LONGS_EQUAL(2, slot.load()->version);
+
+    // 'expected' is stale now: the exchange fails and refreshes it
+    CHECK_FALSE(slot.compare_exchange(expected, make_memcpy_shared_ptr<Config>(3)));
+    LONGS_EQUAL(2, expected->version);
+    LONGS_EQUAL(2, slot.load()->version);
+}
+
+TEST(MEMCPY_ATOMIC_SHARED_PTR, Failed_compare_exchange_releases_outside_the_lock)
+{
+    memcpy_atomic_shared_ptr<Reentrant> slot{make_memcpy_shared_ptr<Reentrant>(nullptr)};
+    memcpy_shared_ptr<Reentrant> expected = make_memcpy_shared_ptr<Reentrant>(&slot); // Last owner of its object
+
+    CHECK_FALSE(slot.compare_exchange(expected, make_memcpy_shared_ptr<Reentrant>(nullptr)));
+    POINTERS_EQUAL(nullptr, expected->slot);
+    CHECK(slot.load().get() != expected.get()); // Replaced by the destructor's store
+}
+
+TEST(MEMCPY_ATOMIC_SHARED_PTR, Many_stores)
+{
+    {
+        memcpy_atomic_shared_ptr<Config> slot;
+        for (int i = 0; i < 20; i++)
+        {
+            slot.store(make_memcpy_shared_ptr<Config>(i));
+        }
+        LONGS_EQUAL(19, slot.load()->version);
+        LONGS_EQUAL(1, Config::live);
+    }
+    LONGS_EQUAL(0, Config::live);
+}
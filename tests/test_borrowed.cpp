@@ -0,0 +1,95 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_borrowed_pointer.h"
+#include "memcpy_shared_pointer.h"
+#include "memcpy_unique_pointer.h"
+
+#include <type_traits>
+
+namespace
+{
+    struct Header
+    {
+        int32_t id;
+    };
+
+    struct Message : Header
+    {
+        int32_t length;
+    };
+
+    int32_t read_id(memcpy_borrowed_ptr<const Header> header) { return header ? header->id : -1; }
+
+    constexpr Message static_message{{7}, 3};
+    constexpr memcpy_borrowed_ptr<const Message> static_view{&static_message};
+    static_assert(static_view->length == 3, "borrowed views work in constant expressions");
+    static_assert(memcpy_borrowed_ptr<const Header>{static_view}.get() == &static_message, "converts like a raw pointer");
+
+    // Borrowing from a temporary owner is rejected at compile time
+    static_assert(std::is_constructible<memcpy_borrowed_ptr<int>, memcpy_shared_ptr<int> &>::value, "");
+    static_assert(!std::is_constructible<memcpy_borrowed_ptr<int>, memcpy_shared_ptr<int> &&>::value, "");
+    static_assert(!std::is_constructible<memcpy_borrowed_ptr<int>, const memcpy_shared_ptr<long> &>::value, "");
+
+    // A no-op deleter drops the release altogether (unless frees are counted)
+    static_assert(std::is_trivially_destructible<memcpy_unique_ptr<Message, memcpy_noop_delete<Message>>>::value ==
+                      !memcpy_stats<Message>::enabled,
+                  "");
+    static_assert(!std::is_trivially_destructible<memcpy_unique_ptr<Message>>::value, "");
+    static_assert(sizeof(memcpy_unique_ptr<Message, memcpy_noop_delete<Message>>) == sizeof(void *), "");
+}
+
+TEST_GROUP(MEMCPY_BORROWED_PTR){};
+
+TEST(MEMCPY_BORROWED_PTR, Empty)
+{
+    memcpy_borrowed_ptr<Header> view;
+    CHECK_FALSE(view);
+    CHECK(view == nullptr);
+    LONGS_EQUAL(-1, read_id(view));
+}
+
+TEST(MEMCPY_BORROWED_PTR, Borrow_from_shared_takes_no_reference)
+{
+    memcpy_shared_ptr<Message> owner = make_memcpy_shared_ptr<Message>(Message{{5}, 0});
+    memcpy_borrowed_ptr<Message> view{owner};
+    POINTERS_EQUAL(owner.get(), view.get());
+    LONGS_EQUAL(1, owner.get_count());
+    LONGS_EQUAL(5, read_id(owner));
+    LONGS_EQUAL(1, owner.get_count());
+}
+
+TEST(MEMCPY_BORROWED_PTR, Borrow_from_unique_keeps_ownership)
+{
+    memcpy_unique_ptr<Message> owner = make_memcpy_unique_ptr<Message>(Message{{9}, 4});
+    auto view = memcpy_borrow(owner);
+    CHECK((std::is_same<decltype(view), memcpy_borrowed_ptr<Message>>::value));
+    view->length = 8;
+    CHECK(owner);
+    LONGS_EQUAL(8, owner->length);
+    LONGS_EQUAL(9, read_id(owner));
+}
+
+TEST(MEMCPY_BORROWED_PTR, Copies_compare_equal)
+{
+    Message message{{1}, 2};
+    memcpy_borrowed_ptr<Message> first{&message};
+    memcpy_borrowed_ptr<Message> second = first;
+    CHECK(first == second);
+    memcpy_borrowed_ptr<const Message> read_only = first;
+    POINTERS_EQUAL(&message, read_only.get());
+}
+
+TEST(MEMCPY_BORROWED_PTR, Noop_deleter_leaves_the_storage_alone)
+{
+    Message message{{3}, 1};
+    {
+        memcpy_unique_ptr<Message, memcpy_noop_delete<Message>> ptr{&message};
+        uint8_t buffer[sizeof(ptr)];
+        CHECK(ptr.memcpy_send(buffer, [](void *const dest, const memcpy_unique_ptr<Message, memcpy_noop_delete<Message>> *src)
+                              { return memcpy(dest, src, sizeof(*src)) != nullptr; }));
+        CHECK_FALSE(ptr);
+        memcpy_unique_ptr<Message, memcpy_noop_delete<Message>> received;
+        received.memcpy_adopt(buffer);
+        POINTERS_EQUAL(&message, received.get());
+    }
+    LONGS_EQUAL(3, message.id); // Still intact: nothing was deleted
+}
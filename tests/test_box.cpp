@@ -0,0 +1,85 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_box.h"
+
+#include <cstring>
+#include <string>
+
+namespace
+{
+    struct Status
+    {
+        uint32_t code;
+        uint32_t timestamp;
+    };
+
+    struct Frame
+    {
+        uint8_t bytes[64];
+    };
+
+    using status_box = memcpy_box<Status>;
+    using string_box = memcpy_box<std::string>;
+}
+
+TEST_GROUP(MEMCPY_BOX){};
+
+TEST(MEMCPY_BOX, Storage_selection)
+{
+    CHECK_TRUE(status_box::is_inline);
+    CHECK_FALSE(memcpy_box<Frame>::is_inline);
+    CHECK_TRUE((memcpy_box<Frame, 64>::is_inline));
+    CHECK_FALSE(string_box::is_inline); // Not trivially copyable
+    LONGS_EQUAL(sizeof(void *), sizeof(memcpy_box<Frame>));
+}
+
+TEST(MEMCPY_BOX, Create_empty_box)
+{
+    status_box box;
+    CHECK_FALSE(box);
+    POINTERS_EQUAL(nullptr, box.get());
+}
+
+TEST(MEMCPY_BOX, Inline_value_lives_in_the_box)
+{
+    status_box box = make_memcpy_box<Status>(Status{7, 100});
+    CHECK(box);
+    LONGS_EQUAL(7, box->code);
+    CHECK(reinterpret_cast<const unsigned char *>(box.get()) >= reinterpret_cast<const unsigned char *>(&box));
+    CHECK(reinterpret_cast<const unsigned char *>(box.get()) < reinterpret_cast<const unsigned char *>(&box) + sizeof(box));
+
+    status_box moved{std::move(box)};
+    CHECK_FALSE(box);
+    LONGS_EQUAL(100, moved->timestamp);
+}
+
+TEST(MEMCPY_BOX, Memcpy_send_receive_inline)
+{
+    status_box sender = make_memcpy_box<Status>(Status{3, 4});
+    uint8_t buffer[sizeof(status_box)];
+    CHECK(sender.memcpy_send(buffer, [](void *dest, const status_box *src)
+                             { memcpy(dest, src, sizeof(status_box)); return true; }));
+    CHECK_FALSE(sender);
+
+    status_box receiver = make_memcpy_box<Status>(Status{9, 9});
+    CHECK(receiver.memcpy_receive(buffer, [](status_box *dest, const void *src)
+                                  { memcpy(static_cast<void *>(dest), src, sizeof(status_box)); return true; }));
+    LONGS_EQUAL(3, receiver->code);
+    LONGS_EQUAL(4, receiver->timestamp);
+}
+
+TEST(MEMCPY_BOX, Memcpy_send_receive_heap)
+{
+    string_box sender = make_memcpy_box<std::string>("hello from the heap");
+    uint8_t buffer[sizeof(string_box)];
+    sender.memcpy_send(buffer, [](void *dest, const string_box *src)
+                       { memcpy(dest, src, sizeof(string_box)); return true; });
+    CHECK_FALSE(sender);
+
+    string_box receiver = make_memcpy_box<std::string>("replaced");
+    receiver.memcpy_receive(buffer, [](string_box *dest, const void *src)
+                            { memcpy(static_cast<void *>(dest), src, sizeof(string_box)); return true; });
+    STRCMP_EQUAL("hello from the heap", receiver->c_str());
+
+    receiver.reset();
+    CHECK_FALSE(receiver);
+}
@@ -0,0 +1,129 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_intrusive_pointer.h"
+
+#include <cstring>
+
+namespace
+{
+    struct Message : memcpy_intrusive_ref_counted<Message>
+    {
+        explicit Message(int value) : value(value) { live++; }
+        ~Message() { live--; }
+        int value;
+        static int live;
+    };
+
+    int Message::live = 0;
+
+    // Counter provided through hand-written ADL hooks instead of the CRTP base
+    struct Legacy
+    {
+        int value = 0;
+        memcpy_ref_count_t refs = 0;
+    };
+
+    void memcpy_intrusive_add_ref(const Legacy *object) { const_cast<Legacy *>(object)->refs++; }
+    void memcpy_intrusive_release(const Legacy *object)
+    {
+        if (--const_cast<Legacy *>(object)->refs == 0)
+        {
+            delete object;
+        }
+    }
+    memcpy_ref_count_t memcpy_intrusive_use_count(const Legacy *object) { return object->refs; }
+
+    using message_ptr = memcpy_intrusive_ptr<Message>;
+}
+
+TEST_GROUP(MEMCPY_INTRUSIVE_PTR){};
+
+TEST(MEMCPY_INTRUSIVE_PTR, One_word_wide)
+{
+    LONGS_EQUAL(sizeof(void *), sizeof(message_ptr));
+}
+
+TEST(MEMCPY_INTRUSIVE_PTR, Create_empty_intrusivePtr)
+{
+    message_ptr ptr;
+    LONGS_EQUAL(0, ptr.get_count());
+    POINTERS_EQUAL(nullptr, ptr.get());
+    CHECK_FALSE(ptr);
+}
+
+TEST(MEMCPY_INTRUSIVE_PTR, Copy_and_move)
+{
+    {
+        message_ptr ptr1 = make_memcpy_intrusive_ptr<Message>(4);
+        LONGS_EQUAL(1, ptr1.get_count());
+        {
+            message_ptr ptr2{ptr1};
+            LONGS_EQUAL(2, ptr1.get_count());
+            message_ptr ptr3{std::move(ptr2)};
+            LONGS_EQUAL(2, ptr3.get_count());
+            POINTERS_EQUAL(nullptr, ptr2.get());
+
+            message_ptr ptr4;
+            ptr4 = ptr3;
+            LONGS_EQUAL(3, ptr1.get_count());
+            ptr4 = ptr4;
+            LONGS_EQUAL(3, ptr1.get_count());
+        }
+        LONGS_EQUAL(1, ptr1.get_count());
+        LONGS_EQUAL(4, ptr1->value);
+    }
+    LONGS_EQUAL(0, Message::live);
+}
+
+TEST(MEMCPY_INTRUSIVE_PTR, Memcpy_send_receive_function)
+{
+    message_ptr ptr1 = make_memcpy_intrusive_ptr<Message>(8);
+    uint8_t buffer[sizeof(message_ptr)];
+
+    CHECK(ptr1.memcpy_send(buffer, [](void *dest, const message_ptr *src)
+                           { memcpy(dest, src, sizeof(message_ptr)); return true; }));
+    LONGS_EQUAL(2, ptr1.get_count()); // The bitwise copy is an owner
+
+    message_ptr ptr2 = make_memcpy_intrusive_ptr<Message>(9);
+    CHECK(ptr2.memcpy_receive(buffer, [](message_ptr *dest, const void *src)
+                              { memcpy(static_cast<void *>(dest), src, sizeof(message_ptr)); return true; }));
+    LONGS_EQUAL(1, Message::live); // Message 9 released
+    LONGS_EQUAL(2, ptr1.get_count());
+    LONGS_EQUAL(8, ptr2->value);
+
+    ptr1.reset();
+    LONGS_EQUAL(1, ptr2.get_count());
+}
+
+TEST(MEMCPY_INTRUSIVE_PTR, Adl_hooks)
+{
+    memcpy_intrusive_ptr<Legacy> ptr1{new Legacy};
+    memcpy_intrusive_ptr<Legacy> ptr2 = ptr1;
+    LONGS_EQUAL(2, ptr1.get_count());
+    ptr2.reset();
+    LONGS_EQUAL(1, ptr1.get_count());
+}
+
+TEST(MEMCPY_INTRUSIVE_PTR, Failed_send_keeps_the_count)
+{
+    message_ptr ptr = make_memcpy_intrusive_ptr<Message>(5);
+    uint8_t buffer[sizeof(message_ptr)];
+    CHECK_FALSE(ptr.memcpy_send(buffer, [](void *const, const message_ptr *const)
+                                { return false; }));
+    LONGS_EQUAL(1, ptr.get_count());
+    LONGS_EQUAL(1, Message::live);
+}
+
+TEST(MEMCPY_INTRUSIVE_PTR, Receiver_may_drop_its_copy_before_send_returns)
+{
+    message_ptr ptr = make_memcpy_intrusive_ptr<Message>(5);
+    uint8_t buffer[sizeof(message_ptr)];
+    // The "receiver" claims and releases the copy inside the copy function, as another core could
+    CHECK(ptr.memcpy_send(buffer, [](void *const dest, const message_ptr *src)
+                          {
+                              memcpy(dest, static_cast<const void *>(src), sizeof(message_ptr));
+                              message_ptr receiver;
+                              receiver.memcpy_adopt(dest);
+                              return true; }));
+    LONGS_EQUAL(1, ptr.get_count());
+    LONGS_EQUAL(5, ptr->value);
+}
@@ -0,0 +1,55 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_lock_policy.h"
+#include "memcpy_shared_pointer.h"
+
+#include <cstring>
+
+TEST_GROUP(MEMCPY_LOCK_POLICY){};
+
+template <class Policy>
+static void check_policy()
+{
+    memcpy_shared_ptr_counter count{1};
+    Policy::increment(count);
+    Policy::increment(count, 3);
+    LONGS_EQUAL(5, Policy::get_count(count));
+    LONGS_EQUAL(5, Policy::decrement(count, 2));
+    LONGS_EQUAL(3, Policy::decrement(count));
+    LONGS_EQUAL(2, Policy::get_count(count));
+}
+
+TEST(MEMCPY_LOCK_POLICY, Single)
+{
+    check_policy<memcpy_lock_policy_single>();
+}
+
+TEST(MEMCPY_LOCK_POLICY, Atomic)
+{
+    check_policy<memcpy_lock_policy_atomic>();
+}
+
+TEST(MEMCPY_LOCK_POLICY, Critical_section)
+{
+    check_policy<memcpy_lock_policy_critical_section>();
+}
+
+TEST(MEMCPY_LOCK_POLICY, Shared_ptr_with_critical_section_policy)
+{
+    using ptr_type = memcpy_shared_ptr<int, memcpy_lock_policy_critical_section>;
+    ptr_type ptr1{new int(3)};
+    uint8_t buffer[sizeof(ptr_type)];
+    CHECK(ptr1.memcpy_send(buffer, [](void *const dest, const ptr_type *src)
+                           { return memcpy(dest, src, sizeof(ptr_type)); }));
+    LONGS_EQUAL(2, ptr1.get_count());
+
+    ptr_type ptr2;
+    CHECK(ptr2.memcpy_receive(buffer, [](ptr_type *dest, const void *const src)
+                              { return memcpy(static_cast<void *>(dest), src, sizeof(ptr_type)); }));
+    LONGS_EQUAL(2, ptr2.get_count());
+
+    memcpy_shared_ptr<int> atomic_ptr;
+    CHECK_FALSE(ptr2.convert_lock_policy(atomic_ptr));
+    ptr1 = ptr_type{};
+    CHECK(ptr2.convert_lock_policy(atomic_ptr));
+    LONGS_EQUAL(3, *atomic_ptr);
+}
@@ -0,0 +1,111 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_mailbox.h"
+
+namespace
+{
+    struct Sample
+    {
+        explicit Sample(int value) : value(value) { live++; }
+        ~Sample() { live--; }
+        int value;
+        static int live;
+    };
+
+    int Sample::live = 0;
+
+    using sample_ptr = memcpy_shared_ptr<Sample>;
+
+    // Publishes into 'mailbox' from its destructor, which only works if it is not freed under the writer lock
+    struct Reentrant
+    {
+        explicit Reentrant(memcpy_shared_mailbox<Reentrant> *mailbox) : mailbox(mailbox) {}
+        ~Reentrant()
+        {
+            if (mailbox != nullptr)
+            {
+                mailbox->publish(make_memcpy_shared_ptr<Reentrant>(nullptr));
+            }
+        }
+        memcpy_shared_mailbox<Reentrant> *mailbox;
+    };
+}
+
+TEST_GROUP(MEMCPY_SHARED_MAILBOX){};
+
+TEST(MEMCPY_SHARED_MAILBOX, Empty_until_published)
+{
+    memcpy_shared_mailbox<Sample> mailbox;
+    POINTERS_EQUAL(nullptr, mailbox.latest().get());
+    LONGS_EQUAL(0, mailbox.sequence());
+
+    sample_ptr out;
+    uint32_t seen = 0;
+    CHECK_FALSE(mailbox.take_newer(out, seen));
+}
+
+TEST(MEMCPY_SHARED_MAILBOX, Publish_overwrites_and_frees_the_stale_sample)
+{
+    memcpy_shared_mailbox<Sample> mailbox;
+    for (int i = 1; i <= 10; i++)
+    {
+        mailbox.publish(make_memcpy_shared_ptr<Sample>(i));
+    }
+    LONGS_EQUAL(1, Sample::live); // Only the newest is kept
+    LONGS_EQUAL(10, mailbox.latest()->value);
+    LONGS_EQUAL(10, mailbox.sequence());
+}
+
+TEST(MEMCPY_SHARED_MAILBOX, Take_newer_only_when_something_was_published)
+{
+    memcpy_shared_mailbox<Sample> mailbox;
+    sample_ptr out;
+    uint32_t seen = 0;
+
+    mailbox.publish(make_memcpy_shared_ptr<Sample>(1));
+    mailbox.publish(make_memcpy_shared_ptr<Sample>(2));
+    CHECK(mailbox.take_newer(out, seen));
+    LONGS_EQUAL(2, out->value); // The stale sample is skipped
+    LONGS_EQUAL(2, out.get_count());
+
+    CHECK_FALSE(mailbox.take_newer(out, seen));
+    LONGS_EQUAL(2, out.get_count()); // No count traffic while nothing changed
+
+    mailbox.publish(make_memcpy_shared_ptr<Sample>(3));
+    CHECK(mailbox.take_newer(out, seen));
+    LONGS_EQUAL(3, out->value);
+    LONGS_EQUAL(1, Sample::live);
+}
+
+TEST(MEMCPY_SHARED_MAILBOX, Reader_keeps_its_sample_alive)
+{
+    memcpy_shared_mailbox<Sample> mailbox;
+    mailbox.publish(make_memcpy_shared_ptr<Sample>(1));
+    sample_ptr held = mailbox.latest();
+
+    mailbox.publish(make_memcpy_shared_ptr<Sample>(2));
+    LONGS_EQUAL(1, held->value);
+    LONGS_EQUAL(1, held.get_count());
+    LONGS_EQUAL(2, Sample::live);
+}
+
+TEST(MEMCPY_SHARED_MAILBOX, Exchange_returns_the_displaced_sample)
+{
+    memcpy_shared_mailbox<Sample> mailbox;
+    mailbox.publish(make_memcpy_shared_ptr<Sample>(1));
+
+    sample_ptr displaced = mailbox.exchange(make_memcpy_shared_ptr<Sample>(2));
+    LONGS_EQUAL(1, displaced->value);
+    LONGS_EQUAL(1, displaced.get_count());
+    LONGS_EQUAL(2, mailbox.latest()->value);
+    LONGS_EQUAL(2, mailbox.sequence());
+}
+
+TEST(MEMCPY_SHARED_MAILBOX, Displaced_sample_is_released_outside_the_lock)
+{
+    memcpy_shared_mailbox<Reentrant> mailbox;
+    mailbox.publish(make_memcpy_shared_ptr<Reentrant>(&mailbox));
+    mailbox.publish(make_memcpy_shared_ptr<Reentrant>(nullptr)); // Frees the first, which publishes again
+
+    LONGS_EQUAL(3, mailbox.sequence());
+    POINTERS_EQUAL(nullptr, mailbox.latest()->mailbox);
+}
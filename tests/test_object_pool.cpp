@@ -0,0 +1,106 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_object_pool.h"
+#include "memcpy_unique_pointer.h"
+#include "memcpy_shared_pointer.h"
+
+#include <cstring>
+
+namespace
+{
+    struct UniquePooledMessage : memcpy_pool_allocated<UniquePooledMessage, 2>
+    {
+        explicit UniquePooledMessage(int value) : value(value) {}
+        int value;
+    };
+
+    struct SharedPooledMessage : memcpy_pool_allocated<SharedPooledMessage, 2>
+    {
+        explicit SharedPooledMessage(int value) : value(value) {}
+        int value;
+    };
+}
+
+TEST_GROUP(MEMCPY_OBJECT_POOL){};
+
+TEST(MEMCPY_OBJECT_POOL, Allocate_until_exhausted)
+{
+    memcpy_object_pool<int, 3> pool;
+    void *a = pool.allocate();
+    void *b = pool.allocate();
+    void *c = pool.allocate();
+    CHECK(a != nullptr);
+    CHECK(b != nullptr);
+    CHECK(c != nullptr);
+    CHECK(pool.owns(a));
+    CHECK(pool.owns(c));
+    POINTERS_EQUAL(nullptr, pool.allocate());
+
+    pool.deallocate(b);
+    POINTERS_EQUAL(b, pool.allocate());
+    POINTERS_EQUAL(nullptr, pool.allocate());
+
+    pool.deallocate(a);
+    pool.deallocate(b);
+    pool.deallocate(c);
+    CHECK(pool.allocate() != nullptr);
+}
+
+TEST(MEMCPY_OBJECT_POOL, Owns)
+{
+    memcpy_object_pool<int, 1> pool;
+    int local = 0;
+    CHECK_FALSE(pool.owns(&local));
+}
+
+TEST(MEMCPY_OBJECT_POOL, Unique_ptr_from_pool)
+{
+    {
+        memcpy_unique_ptr<UniquePooledMessage> ptr1 = make_memcpy_unique_ptr<UniquePooledMessage>(1);
+        memcpy_unique_ptr<UniquePooledMessage> ptr2 = make_memcpy_unique_ptr<UniquePooledMessage>(2);
+        memcpy_unique_ptr<UniquePooledMessage> ptr3 = make_memcpy_unique_ptr<UniquePooledMessage>(3);
+        CHECK(UniquePooledMessage::pool().owns(ptr1.get()));
+        LONGS_EQUAL(2, ptr2->value);
+        CHECK_FALSE(static_cast<bool>(ptr3)); // Pool exhausted
+    }
+    // Destructors returned both slots
+    memcpy_unique_ptr<UniquePooledMessage> ptr4 = make_memcpy_unique_ptr<UniquePooledMessage>(4);
+    memcpy_unique_ptr<UniquePooledMessage> ptr5 = make_memcpy_unique_ptr<UniquePooledMessage>(5);
+    CHECK(static_cast<bool>(ptr4));
+    CHECK(static_cast<bool>(ptr5));
+}
+
+TEST(MEMCPY_OBJECT_POOL, Unique_ptr_from_pool_send_receive)
+{
+    memcpy_unique_ptr<UniquePooledMessage> ptr1 = make_memcpy_unique_ptr<UniquePooledMessage>(60);
+    uint8_t buffer[sizeof(memcpy_unique_ptr<UniquePooledMessage>)];
+    bool sent = ptr1.memcpy_send(buffer, [](void *dest, const memcpy_unique_ptr<UniquePooledMessage> *src)
+                                 { return memcpy(dest, src, sizeof(memcpy_unique_ptr<UniquePooledMessage>)); });
+    CHECK(sent);
+
+    memcpy_unique_ptr<UniquePooledMessage> ptr2;
+    bool received = ptr2.memcpy_receive(buffer, [](memcpy_unique_ptr<UniquePooledMessage> *dest, const void *src)
+                                        { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_unique_ptr<UniquePooledMessage>)); });
+    CHECK(received);
+    LONGS_EQUAL(60, ptr2->value);
+    CHECK(UniquePooledMessage::pool().owns(ptr2.get()));
+}
+
+TEST(MEMCPY_OBJECT_POOL, Shared_ptr_from_pool)
+{
+    {
+        memcpy_shared_ptr<SharedPooledMessage> ptr1 = make_memcpy_shared_ptr<SharedPooledMessage>(1);
+        memcpy_shared_ptr<SharedPooledMessage> ptr2 = make_memcpy_shared_ptr<SharedPooledMessage>(2);
+        memcpy_shared_ptr<SharedPooledMessage> ptr3 = make_memcpy_shared_ptr<SharedPooledMessage>(3);
+        LONGS_EQUAL(1, ptr1->value);
+        LONGS_EQUAL(1, ptr2.get_count());
+        POINTERS_EQUAL(nullptr, ptr3.get()); // Pool exhausted
+        LONGS_EQUAL(0, ptr3.get_count());
+
+        memcpy_shared_ptr<SharedPooledMessage> ptr4 = ptr1;
+        LONGS_EQUAL(2, ptr1.get_count());
+    }
+    memcpy_shared_ptr<SharedPooledMessage> ptr5 = make_memcpy_shared_ptr<SharedPooledMessage>(5);
+    memcpy_shared_ptr<SharedPooledMessage> ptr6 = make_memcpy_shared_ptr<SharedPooledMessage>(6);
+    LONGS_EQUAL(5, ptr5->value);
+    LONGS_EQUAL(6, ptr6->value);
+}
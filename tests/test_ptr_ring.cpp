@@ -0,0 +1,118 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_ptr_ring.h"
+#include "memcpy_unique_pointer.h"
+#include "memcpy_shared_pointer.h"
+
+TEST_GROUP(MEMCPY_PTR_RING){};
+
+TEST(MEMCPY_PTR_RING, SPSC_unique_push_pop)
+{
+    memcpy_spsc_ring<memcpy_unique_ptr<int>, 4> ring;
+    CHECK(ring.empty());
+
+    for (int i = 0; i < 4; i++)
+    {
+        memcpy_unique_ptr<int> ptr{new int(i)};
+        CHECK(ring.push(ptr));
+        CHECK(ptr.get() == nullptr);
+    }
+    LONGS_EQUAL(4, ring.size());
+
+    memcpy_unique_ptr<int> overflow{new int(99)};
+    CHECK_FALSE(ring.push(overflow));
+    CHECK(*overflow == 99); // Still owned by the caller
+
+    for (int i = 0; i < 4; i++)
+    {
+        memcpy_unique_ptr<int> out;
+        CHECK(ring.pop(out));
+        CHECK(*out == i);
+    }
+    memcpy_unique_ptr<int> out;
+    CHECK_FALSE(ring.pop(out));
+    CHECK(ring.empty());
+}
+
+TEST(MEMCPY_PTR_RING, SPSC_wraps_around)
+{
+    memcpy_spsc_ring<memcpy_unique_ptr<int>, 2> ring;
+    for (int i = 0; i < 10; i++)
+    {
+        memcpy_unique_ptr<int> ptr{new int(i)};
+        CHECK(ring.push(ptr));
+        memcpy_unique_ptr<int> out;
+        CHECK(ring.pop(out));
+        CHECK(*out == i);
+    }
+}
+
+TEST(MEMCPY_PTR_RING, SPSC_shared_reference_counts)
+{
+    memcpy_shared_ptr<int> ptr{new int(7)};
+    {
+        memcpy_spsc_ring<memcpy_shared_ptr<int>, 4> ring;
+        CHECK(ring.push(ptr));
+        CHECK(ring.push(ptr));
+        LONGS_EQUAL(3, ptr.get_count());
+
+        memcpy_shared_ptr<int> out;
+        CHECK(ring.pop(out));
+        LONGS_EQUAL(3, ptr.get_count());
+        LONGS_EQUAL(7, *out);
+    }
+    // 'out' and the item still queued when the ring was destroyed are both released
+    LONGS_EQUAL(1, ptr.get_count());
+}
+
+TEST(MEMCPY_PTR_RING, SPSC_destructor_drains_unique)
+{
+    memcpy_spsc_ring<memcpy_unique_ptr<int>, 2> ring;
+    memcpy_unique_ptr<int> ptr{new int(1)};
+    CHECK(ring.push(ptr));
+    // Leak checking verifies the queued object is deleted with the ring
+}
+
+TEST(MEMCPY_PTR_RING, MPSC_unique_push_pop)
+{
+    memcpy_mpsc_ring<memcpy_unique_ptr<int>, 4> ring;
+    for (int i = 0; i < 4; i++)
+    {
+        memcpy_unique_ptr<int> ptr{new int(i)};
+        CHECK(ring.push(ptr));
+    }
+    memcpy_unique_ptr<int> overflow{new int(99)};
+    CHECK_FALSE(ring.push(overflow));
+    CHECK(*overflow == 99);
+
+    for (int lap = 0; lap < 3; lap++)
+    {
+        memcpy_unique_ptr<int> out;
+        CHECK(ring.pop(out));
+        memcpy_unique_ptr<int> ptr{new int(10 + lap)};
+        CHECK(ring.push(ptr));
+    }
+    LONGS_EQUAL(4, ring.size());
+
+    int expected[] = {3, 10, 11, 12};
+    for (int value : expected)
+    {
+        memcpy_unique_ptr<int> out;
+        CHECK(ring.pop(out));
+        CHECK(*out == value);
+    }
+    memcpy_unique_ptr<int> out;
+    CHECK_FALSE(ring.pop(out));
+}
+
+TEST(MEMCPY_PTR_RING, MPSC_shared_destructor_drains)
+{
+    memcpy_shared_ptr<int> ptr = make_memcpy_shared_ptr<int>(3);
+    {
+        memcpy_mpsc_ring<memcpy_shared_ptr<int>, 8> ring;
+        CHECK(ring.push(ptr));
+        CHECK(ring.push(ptr));
+        CHECK(ring.push(ptr));
+        LONGS_EQUAL(4, ptr.get_count());
+    }
+    LONGS_EQUAL(1, ptr.get_count());
+}
@@ -0,0 +1,100 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_shared_pointer.h"
+
+#include <cstring>
+
+namespace
+{
+    struct BigFrame
+    {
+        explicit BigFrame(int value) : value(value) { live++; }
+        ~BigFrame() { live--; }
+        int value;
+        uint8_t payload[256] = {};
+        static int live;
+    };
+
+    int BigFrame::live = 0;
+
+    using deferred_ptr = memcpy_shared_ptr<BigFrame, memcpy_lock_policy_deferred<>>;
+
+    int reclaimed = 0;
+    void count_reclaim(memcpy_shared_ptr_control_block *) { reclaimed++; }
+}
+
+TEST_GROUP(MEMCPY_RECLAIM){};
+
+TEST(MEMCPY_RECLAIM, Last_release_is_deferred)
+{
+    {
+        deferred_ptr ptr1{new BigFrame(1)};
+        deferred_ptr ptr2 = ptr1;
+    }
+    LONGS_EQUAL(1, BigFrame::live); // Still waiting on the retire list
+    LONGS_EQUAL(1, memcpy_reclaim_pending());
+
+    LONGS_EQUAL(1, memcpy_reclaim_drain());
+    LONGS_EQUAL(0, BigFrame::live);
+    LONGS_EQUAL(0, memcpy_reclaim_pending());
+}
+
+TEST(MEMCPY_RECLAIM, Drain_in_batches)
+{
+    for (int i = 0; i < 5; i++)
+    {
+        deferred_ptr ptr{new BigFrame(i)};
+    }
+    LONGS_EQUAL(5, BigFrame::live);
+
+    LONGS_EQUAL(2, memcpy_reclaim_drain(2));
+    LONGS_EQUAL(3, BigFrame::live);
+    LONGS_EQUAL(3, memcpy_reclaim_drain());
+    LONGS_EQUAL(0, BigFrame::live);
+}
+
+TEST(MEMCPY_RECLAIM, Expired_for_weak_observers_before_drain)
+{
+    memcpy_weak_ptr<BigFrame, memcpy_lock_policy_deferred<>> weak;
+    {
+        deferred_ptr ptr{new BigFrame(3)};
+        weak = ptr;
+    }
+    CHECK_TRUE(weak.expired());
+    POINTERS_EQUAL(nullptr, weak.lock().get());
+    memcpy_reclaim_drain();
+    LONGS_EQUAL(0, BigFrame::live);
+}
+
+TEST(MEMCPY_RECLAIM, Full_list_reclaims_immediately)
+{
+    for (std::size_t i = 0; i < MEMCPY_SMART_PTR_RECLAIM_CAPACITY + 1; i++)
+    {
+        deferred_ptr ptr{new BigFrame(0)};
+    }
+    LONGS_EQUAL(MEMCPY_SMART_PTR_RECLAIM_CAPACITY, BigFrame::live);
+    LONGS_EQUAL(MEMCPY_SMART_PTR_RECLAIM_CAPACITY, memcpy_reclaim_drain());
+}
+
+TEST(MEMCPY_RECLAIM, Default_policy_is_not_deferred)
+{
+    {
+        memcpy_shared_ptr<BigFrame> ptr{new BigFrame(4)};
+    }
+    LONGS_EQUAL(0, BigFrame::live);
+    LONGS_EQUAL(0, memcpy_reclaim_pending());
+}
+
+TEST(MEMCPY_RECLAIM, Destroyed_list_reclaims_what_is_left)
+{
+    reclaimed = 0;
+    {
+        memcpy_reclaim_ring list;
+        for (int i = 0; i < 3; i++)
+        {
+            memcpy_reclaim_entry entry{nullptr, count_reclaim};
+            CHECK(list.push(entry));
+        }
+        LONGS_EQUAL(1, list.reclaim(1));
+    }
+    LONGS_EQUAL(3, reclaimed);
+}
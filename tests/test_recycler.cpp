@@ -0,0 +1,119 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_recycler.h"
+
+#include <cstring>
+
+namespace
+{
+    struct Frame
+    {
+        explicit Frame(int value) : value(value) { live++; }
+        ~Frame() { live--; }
+        int value;
+        static int live;
+    };
+
+    int Frame::live = 0;
+
+    using frame_ptr = memcpy_recycled_unique_ptr<Frame>;
+
+    struct Picky
+    {
+        explicit Picky(int value) : value(value)
+        {
+            if (value < 0)
+            {
+                throw value;
+            }
+        }
+        int value;
+    };
+}
+
+TEST_GROUP(MEMCPY_RECYCLER){};
+
+TEST(MEMCPY_RECYCLER, Storage_is_reused)
+{
+    memcpy_recycler<Frame> recycler;
+    Frame *first;
+    {
+        frame_ptr ptr = make_memcpy_recycled_unique_ptr(recycler, 1);
+        CHECK(ptr);
+        LONGS_EQUAL(1, ptr->value);
+        LONGS_EQUAL(1, Frame::live);
+        first = ptr.get();
+    }
+    LONGS_EQUAL(0, Frame::live); // Destroyed, storage kept
+
+    frame_ptr again = make_memcpy_recycled_unique_ptr(recycler, 2);
+    POINTERS_EQUAL(first, again.get());
+    LONGS_EQUAL(2, again->value);
+
+    again.reset(nullptr);
+    LONGS_EQUAL(0, Frame::live);
+}
+
+TEST(MEMCPY_RECYCLER, Returned_through_a_buffer)
+{
+    memcpy_recycler<Frame> recycler;
+    CHECK(recycler.reserve(1));
+
+    frame_ptr sender = recycler.make(7);
+    Frame *object = sender.get();
+    LONGS_EQUAL(sizeof(void *) * 2, sizeof(frame_ptr));
+
+    uint8_t buffer[sizeof(frame_ptr)];
+    sender.memcpy_send(buffer, [](void *dest, const frame_ptr *src)
+                       { memcpy(dest, src, sizeof(frame_ptr)); return true; });
+    CHECK_FALSE(sender);
+
+    {
+        frame_ptr receiver;
+        receiver.memcpy_receive(buffer, [](frame_ptr *dest, const void *src)
+                                { memcpy(static_cast<void *>(dest), src, sizeof(frame_ptr)); return true; });
+        LONGS_EQUAL(7, receiver->value);
+        POINTERS_EQUAL(&recycler, receiver.get_deleter().owner);
+    } // Consumer drops it: storage goes back to the recycler
+
+    frame_ptr next = recycler.make(8);
+    POINTERS_EQUAL(object, next.get());
+}
+
+TEST(MEMCPY_RECYCLER, Several_in_flight)
+{
+    memcpy_recycler<Frame> recycler;
+    {
+        frame_ptr a = recycler.make(1);
+        frame_ptr b = recycler.make(2);
+        frame_ptr c = recycler.make(3);
+        CHECK(a.get() != b.get());
+        CHECK(b.get() != c.get());
+        LONGS_EQUAL(3, Frame::live);
+    }
+    LONGS_EQUAL(0, Frame::live);
+
+    frame_ptr a = recycler.make(4);
+    frame_ptr b = recycler.make(5);
+    frame_ptr c = recycler.make(6);
+    LONGS_EQUAL(3, Frame::live);
+}
+
+TEST(MEMCPY_RECYCLER, Throwing_constructor_gives_the_slot_back)
+{
+    memcpy_recycler<Picky> recycler;
+    Picky *first = make_memcpy_recycled_unique_ptr(recycler, 1).get(); // Destroyed at once, storage kept
+
+    bool thrown = false;
+    try
+    {
+        make_memcpy_recycled_unique_ptr(recycler, -1);
+    }
+    catch (int)
+    {
+        thrown = true;
+    }
+    CHECK(thrown);
+
+    memcpy_recycled_unique_ptr<Picky> again = make_memcpy_recycled_unique_ptr(recycler, 2);
+    POINTERS_EQUAL(first, again.get());
+}
@@ -0,0 +1,84 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_relocate.h"
+#include "memcpy_unique_pointer.h"
+#include "memcpy_shared_pointer.h"
+#include "memcpy_intrusive_pointer.h"
+#include "memcpy_box.h"
+
+#include <string>
+
+namespace
+{
+    struct Counted
+    {
+        explicit Counted(int value) : value(value) {}
+        Counted(Counted &&other) noexcept : value(other.value) { moves++; }
+        ~Counted() { destructions++; }
+        int value;
+        static int moves;
+        static int destructions;
+    };
+
+    int Counted::moves = 0;
+    int Counted::destructions = 0;
+}
+
+TEST_GROUP(MEMCPY_RELOCATE){};
+
+TEST(MEMCPY_RELOCATE, Trait)
+{
+    CHECK_TRUE(memcpy_is_trivially_relocatable_v<memcpy_unique_ptr<std::string>>);
+    CHECK_TRUE(memcpy_is_trivially_relocatable_v<memcpy_shared_ptr<std::string>>);
+    CHECK_TRUE(memcpy_is_trivially_relocatable_v<memcpy_weak_ptr<std::string>>);
+    CHECK_TRUE(memcpy_is_trivially_relocatable_v<memcpy_box<std::string>>);
+    CHECK_TRUE(memcpy_is_trivially_relocatable_v<int>);
+    CHECK_FALSE(memcpy_is_trivially_relocatable_v<Counted>);
+}
+
+TEST(MEMCPY_RELOCATE, Shared_ptrs_keep_their_count)
+{
+    using ptr_type = memcpy_shared_ptr<int>;
+    memcpy_shared_ptr<int> owner{new int(6)};
+
+    alignas(ptr_type) unsigned char from[3 * sizeof(ptr_type)];
+    alignas(ptr_type) unsigned char to[3 * sizeof(ptr_type)];
+    ptr_type *first = reinterpret_cast<ptr_type *>(from);
+    for (int i = 0; i < 3; i++)
+    {
+        new (first + i) ptr_type{owner};
+    }
+    LONGS_EQUAL(4, owner.get_count());
+
+    ptr_type *dest = reinterpret_cast<ptr_type *>(to);
+    ptr_type *end = memcpy_relocate(first, first + 3, dest);
+    POINTERS_EQUAL(dest + 3, end);
+    LONGS_EQUAL(4, owner.get_count()); // No copies, no releases
+    LONGS_EQUAL(6, *dest[2]);
+
+    for (int i = 0; i < 3; i++)
+    {
+        dest[i].~ptr_type();
+    }
+    LONGS_EQUAL(1, owner.get_count());
+}
+
+TEST(MEMCPY_RELOCATE, Fallback_moves_and_destroys)
+{
+    Counted::moves = 0;
+    Counted::destructions = 0;
+
+    alignas(Counted) unsigned char from[2 * sizeof(Counted)];
+    alignas(Counted) unsigned char to[2 * sizeof(Counted)];
+    Counted *first = reinterpret_cast<Counted *>(from);
+    new (first) Counted{1};
+    new (first + 1) Counted{2};
+
+    Counted *dest = reinterpret_cast<Counted *>(to);
+    memcpy_relocate(first, first + 2, dest);
+    LONGS_EQUAL(2, Counted::moves);
+    LONGS_EQUAL(2, Counted::destructions);
+    LONGS_EQUAL(2, dest[1].value);
+
+    dest[0].~Counted();
+    dest[1].~Counted();
+}
@@ -13,6 +13,17 @@ TEST(MEMCPY_SHARED_PRR, Create_null_sharedPtr)
     POINTERS_EQUAL(nullptr, ptr1.get());
 }
 
+TEST(MEMCPY_SHARED_PRR, Create_sharedPtr_from_nullptr)
+{
+    memcpy_shared_ptr<int> ptr1{nullptr};
+    LONGS_EQUAL(0, ptr1.get_count());
+    POINTERS_EQUAL(nullptr, ptr1.get());
+
+    memcpy_shared_ptr<int> ptr2{new int(5)};
+    ptr2 = nullptr;
+    LONGS_EQUAL(0, ptr2.get_count());
+}
+
 TEST(MEMCPY_SHARED_PRR, Create_sharedPtr)
 {
     memcpy_shared_ptr<int> ptr1{new int(5)};
@@ -174,7 +185,7 @@ TEST(MEMCPY_SHARED_PRR, Memcpy_send_receive_function)
 
     memcpy_shared_ptr<int> ptr2;
     bool received = ptr2.memcpy_receive(buffer, [](memcpy_shared_ptr<int> *dest, const void *const src)
-                                        { return memcpy(dest, src, sizeof(memcpy_shared_ptr<int>)); });
+                                        { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_shared_ptr<int>)); });
     CHECK(received);
     LONGS_EQUAL(2, ptr1.get_count());
     LONGS_EQUAL(70, *ptr1.get());
@@ -196,7 +207,7 @@ TEST(MEMCPY_SHARED_PRR, Memcpy_receive_function2)
 
     memcpy_shared_ptr<int> ptr2(new int(100));
     bool received = ptr2.memcpy_receive(buffer, [](memcpy_shared_ptr<int> *dest, const void *const src)
-                                        { return memcpy(dest, src, sizeof(memcpy_shared_ptr<int>)); });
+                                        { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_shared_ptr<int>)); });
     CHECK(received);
     LONGS_EQUAL(2, ptr1.get_count());
     LONGS_EQUAL(70, *ptr1.get());
@@ -205,6 +216,228 @@ TEST(MEMCPY_SHARED_PRR, Memcpy_receive_function2)
     LONGS_EQUAL(70, *ptr2.get());
 }
 
+TEST(MEMCPY_SHARED_PRR, MOVE_ASSIGNMENT_releases_shared_reference)
+{
+    memcpy_shared_ptr<int> ptr1{new int(1)};
+    memcpy_shared_ptr<int> ptr2 = ptr1;
+    LONGS_EQUAL(2, ptr1.get_count());
+
+    memcpy_shared_ptr<int> ptr3{new int(3)};
+    ptr2 = std::move(ptr3);
+
+    LONGS_EQUAL(1, ptr1.get_count());
+    LONGS_EQUAL(1, *ptr1);
+    LONGS_EQUAL(1, ptr2.get_count());
+    LONGS_EQUAL(3, *ptr2);
+}
+
+TEST(MEMCPY_SHARED_PRR, Memcpy_receive_into_shared_owner)
+{
+    memcpy_shared_ptr<int> ptr1{new int(70)};
+    uint8_t buffer[sizeof(memcpy_shared_ptr<int>)];
+    bool sent = ptr1.memcpy_send(buffer, [](void *const dest, const memcpy_shared_ptr<int> *src)
+                                 { return memcpy(dest, src, sizeof(memcpy_shared_ptr<int>)); });
+    CHECK(sent);
+
+    memcpy_shared_ptr<int> ptr2{new int(100)};
+    memcpy_shared_ptr<int> ptr3 = ptr2;
+    LONGS_EQUAL(2, ptr2.get_count());
+
+    // ptr3 gives up its share of 100; ptr2 must keep it alive.
+    bool received = ptr3.memcpy_receive(buffer, [](memcpy_shared_ptr<int> *dest, const void *const src)
+                                        { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_shared_ptr<int>)); });
+    CHECK(received);
+    LONGS_EQUAL(1, ptr2.get_count());
+    LONGS_EQUAL(100, *ptr2);
+    LONGS_EQUAL(2, ptr3.get_count());
+    LONGS_EQUAL(70, *ptr3);
+}
+
+TEST(MEMCPY_SHARED_PRR, Memcpy_receive_in_place_when_empty)
+{
+    memcpy_shared_ptr<int> ptr1{new int(70)};
+    uint8_t buffer[sizeof(memcpy_shared_ptr<int>)];
+    ptr1.memcpy_send(buffer, [](void *const dest, const memcpy_shared_ptr<int> *src)
+                     { return memcpy(dest, src, sizeof(memcpy_shared_ptr<int>)); });
+
+    memcpy_shared_ptr<int> ptr2;
+    memcpy_shared_ptr<int> *written = nullptr;
+    bool received = ptr2.memcpy_receive(buffer, [&written](memcpy_shared_ptr<int> *dest, const void *const src)
+                                        { written = dest; return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_shared_ptr<int>)); });
+    CHECK(received);
+    POINTERS_EQUAL(&ptr2, written); // No temporary buffer
+    LONGS_EQUAL(2, ptr2.get_count());
+    LONGS_EQUAL(70, *ptr2);
+}
+
+TEST(MEMCPY_SHARED_PRR, Memcpy_adopt)
+{
+    memcpy_shared_ptr<int> ptr1{new int(5)};
+    uint8_t buffer[sizeof(memcpy_shared_ptr<int>)];
+    ptr1.memcpy_send(buffer, [](void *const dest, const memcpy_shared_ptr<int> *src)
+                     { return memcpy(dest, src, sizeof(memcpy_shared_ptr<int>)); });
+
+    memcpy_shared_ptr<int> ptr2{new int(6)};
+    ptr2.memcpy_adopt(buffer);
+    LONGS_EQUAL(2, ptr1.get_count());
+    LONGS_EQUAL(5, *ptr2);
+}
+
+TEST(MEMCPY_SHARED_PRR, Memcpy_send_receive_from_isr)
+{
+    memcpy_shared_ptr<int> ptr1 = make_memcpy_shared_ptr<int>(44);
+    uint8_t buffer[sizeof(memcpy_shared_ptr<int>)];
+    CHECK(ptr1.memcpy_send_from_isr(buffer, [](void *const dest, const memcpy_shared_ptr<int> *src)
+                                    { return memcpy(dest, src, sizeof(memcpy_shared_ptr<int>)); }));
+    LONGS_EQUAL(2, ptr1.get_count());
+
+    memcpy_shared_ptr<int> busy{new int(1)};
+    CHECK_FALSE(busy.memcpy_receive_from_isr(buffer, [](memcpy_shared_ptr<int> *dest, const void *const src)
+                                             { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_shared_ptr<int>)); }));
+    LONGS_EQUAL(1, *busy);
+
+    memcpy_shared_ptr<int> ptr2;
+    CHECK(ptr2.memcpy_receive_from_isr(buffer, [](memcpy_shared_ptr<int> *dest, const void *const src)
+                                       { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_shared_ptr<int>)); }));
+    LONGS_EQUAL(2, ptr2.get_count());
+    LONGS_EQUAL(44, *ptr2);
+}
+
+TEST(MEMCPY_SHARED_PRR, Memcpy_send_from_isr_with_critical_section_policy)
+{
+    // memcpy_lock_policy_single is not ISR safe, so memcpy_send_from_isr rejects a memcpy_local_shared_ptr at compile time
+    CHECK_FALSE(memcpy_lock_policy_single::isr_safe);
+    CHECK(memcpy_lock_policy_critical_section::isr_safe);
+
+    using isr_shared_ptr = memcpy_shared_ptr<int, memcpy_lock_policy_critical_section>;
+    isr_shared_ptr ptr1{new int(5)};
+    uint8_t buffer[sizeof(isr_shared_ptr)];
+    CHECK(ptr1.memcpy_send_from_isr(buffer, [](void *const dest, const isr_shared_ptr *src)
+                                    { return memcpy(dest, src, sizeof(isr_shared_ptr)); }));
+    LONGS_EQUAL(2, ptr1.get_count());
+
+    isr_shared_ptr ptr2;
+    ptr2.memcpy_adopt(buffer);
+}
+
+TEST(MEMCPY_SHARED_PRR, Memcpy_send_receive_batch)
+{
+    memcpy_shared_ptr<int> frame{new int(5)};
+    memcpy_shared_ptr<int> other{new int(6)};
+    memcpy_shared_ptr<int> ptrs[4] = {frame, frame, frame, other};
+    LONGS_EQUAL(4, frame.get_count());
+    uint8_t buffer[sizeof(ptrs)];
+
+    bool sent = memcpy_shared_ptr<int>::memcpy_send_batch(ptrs, buffer, [](void *const dest, const memcpy_shared_ptr<int> *src, std::size_t count)
+                                                          { return memcpy(dest, src, count * sizeof(memcpy_shared_ptr<int>)); });
+    CHECK(sent);
+    LONGS_EQUAL(7, frame.get_count());
+    LONGS_EQUAL(3, other.get_count());
+
+    // Releasing the senders' copies leaves the buffer and the originals as owners
+    memcpy_shared_ptr<int> received[4] = {};
+    for (auto &ptr : ptrs)
+    {
+        ptr = memcpy_shared_ptr<int>{};
+    }
+    LONGS_EQUAL(4, frame.get_count());
+
+    bool ok = memcpy_shared_ptr<int>::memcpy_receive_batch(received, buffer, [](memcpy_shared_ptr<int> *dest, const void *const src, std::size_t count)
+                                                           { return memcpy(static_cast<void *>(dest), src, count * sizeof(memcpy_shared_ptr<int>)); });
+    CHECK(ok);
+    LONGS_EQUAL(4, frame.get_count());
+    LONGS_EQUAL(2, other.get_count());
+    LONGS_EQUAL(5, *received[2]);
+    LONGS_EQUAL(6, *received[3]);
+}
+
+TEST(MEMCPY_SHARED_PRR, Memcpy_receive_batch_releases_last_owner)
+{
+    memcpy_shared_ptr<int> ptrs[2] = {memcpy_shared_ptr<int>{new int(1)}};
+    ptrs[1] = ptrs[0];
+    LONGS_EQUAL(2, ptrs[0].get_count());
+
+    bool ok = memcpy_shared_ptr<int>::memcpy_receive_batch(ptrs, nullptr, [](memcpy_shared_ptr<int> *, const void *const, std::size_t)
+                                                           { return false; });
+    CHECK_FALSE(ok);
+    LONGS_EQUAL(0, ptrs[0].get_count());
+    POINTERS_EQUAL(nullptr, ptrs[1].get());
+}
+
+TEST(MEMCPY_SHARED_PRR, Memcpy_send_block_and_adopt)
+{
+    memcpy_shared_ptr<std::string> ptr1 = make_memcpy_shared_ptr<std::string>("one word");
+    memcpy_shared_ptr_control_block *word = nullptr;
+
+    bool sent = ptr1.memcpy_send_block([&word](memcpy_shared_ptr_control_block *const block)
+                                       { word = block; return true; });
+    CHECK(sent);
+    LONGS_EQUAL(2, ptr1.get_count());
+
+    memcpy_shared_ptr<std::string> ptr2 = make_memcpy_shared_ptr<std::string>("replaced");
+    ptr2.memcpy_adopt_block(word);
+    POINTERS_EQUAL(ptr1.get(), ptr2.get());
+    LONGS_EQUAL(2, ptr2.get_count());
+    STRCMP_EQUAL("one word", ptr2->c_str());
+}
+
+TEST(MEMCPY_SHARED_PRR, Memcpy_send_block_failure_keeps_count)
+{
+    memcpy_shared_ptr<int> ptr{new int(4)};
+    bool sent = ptr.memcpy_send_block([](memcpy_shared_ptr_control_block *const)
+                                      { return false; });
+    CHECK_FALSE(sent);
+    LONGS_EQUAL(1, ptr.get_count());
+}
+
+TEST(MEMCPY_SHARED_PRR, Failed_sends_keep_the_count)
+{
+    memcpy_shared_ptr<int> ptr{new int(4)};
+    uint8_t buffer[sizeof(memcpy_shared_ptr<int>)];
+    CHECK_FALSE(ptr.memcpy_send(buffer, [](void *const, const memcpy_shared_ptr<int> *const)
+                                { return false; }));
+    LONGS_EQUAL(1, ptr.get_count());
+    CHECK_FALSE(ptr.memcpy_send_from_isr(buffer, [](void *const, const memcpy_shared_ptr<int> *const)
+                                         { return false; }));
+    LONGS_EQUAL(1, ptr.get_count());
+
+    memcpy_shared_ptr<int> ptrs[2] = {ptr, ptr};
+    CHECK_FALSE(memcpy_shared_ptr<int>::memcpy_send_batch(ptrs, buffer, [](void *const, const memcpy_shared_ptr<int> *, std::size_t)
+                                                          { return false; }));
+    LONGS_EQUAL(3, ptr.get_count());
+}
+
+// The "receiver" claims and releases the copy inside the copy function, as a woken task or the other core could
+TEST(MEMCPY_SHARED_PRR, Receiver_may_drop_its_copy_before_send_returns)
+{
+    memcpy_shared_ptr<int> ptr{new int(4)};
+    uint8_t buffer[sizeof(memcpy_shared_ptr<int>)];
+    CHECK(ptr.memcpy_send(buffer, [](void *const dest, const memcpy_shared_ptr<int> *src)
+                          {
+                              memcpy(dest, static_cast<const void *>(src), sizeof(memcpy_shared_ptr<int>));
+                              memcpy_shared_ptr<int> receiver;
+                              receiver.memcpy_adopt(dest);
+                              return true; }));
+    LONGS_EQUAL(1, ptr.get_count());
+    LONGS_EQUAL(4, *ptr);
+
+    CHECK(ptr.memcpy_send_from_isr(buffer, [](void *const dest, const memcpy_shared_ptr<int> *src)
+                                   {
+                                       memcpy(dest, static_cast<const void *>(src), sizeof(memcpy_shared_ptr<int>));
+                                       memcpy_shared_ptr<int> receiver;
+                                       receiver.memcpy_adopt(dest);
+                                       return true; }));
+    LONGS_EQUAL(1, ptr.get_count());
+
+    CHECK(ptr.memcpy_send_block([](memcpy_shared_ptr_control_block *const block)
+                                {
+                                    memcpy_shared_ptr<int> receiver;
+                                    receiver.memcpy_adopt_block(block);
+                                    return true; }));
+    LONGS_EQUAL(1, ptr.get_count());
+    LONGS_EQUAL(4, *ptr);
+}
+
 TEST_GROUP(MAKE_MEMCPY_SHARED_PTR){};
 
 TEST(MAKE_MEMCPY_SHARED_PTR, MAKE_SHARED_PTR_INT)
@@ -215,4 +448,219 @@ TEST(MAKE_MEMCPY_SHARED_PTR, MAKE_SHARED_PTR_INT)
 TEST(MAKE_MEMCPY_SHARED_PTR, MAKE_SHARED_PTR_STRING)
 {
     memcpy_shared_ptr<std::string> ptr = make_memcpy_shared_ptr<std::string>("This is Tolulope Matthew Busoye");
-}
\ No newline at end of file
+}
+
+TEST(MAKE_MEMCPY_SHARED_PTR, MAKE_SHARED_PTR_MULTI_ARGUMENT)
+{
+    memcpy_shared_ptr<std::string> ptr = make_memcpy_shared_ptr<std::string>(3, 'a');
+    LONGS_EQUAL(1, ptr.get_count());
+    STRCMP_EQUAL("aaa", ptr->c_str());
+}
+
+namespace
+{
+    struct Reading
+    {
+        uint16_t sensor;
+        int32_t value;
+    };
+}
+
+TEST(MAKE_MEMCPY_SHARED_PTR, MAKE_SHARED_PTR_AGGREGATE)
+{
+    memcpy_shared_ptr<Reading> ptr = make_memcpy_shared_ptr<Reading>(uint16_t{3}, 15);
+    LONGS_EQUAL(3, ptr->sensor);
+    LONGS_EQUAL(15, ptr->value);
+}
+
+TEST(MAKE_MEMCPY_SHARED_PTR, MAKE_SHARED_PTR_FOR_OVERWRITE)
+{
+    memcpy_shared_ptr<Reading> ptr = make_memcpy_shared_ptr_for_overwrite<Reading>();
+    CHECK(ptr.get() != nullptr);
+    LONGS_EQUAL(1, ptr.get_count());
+    ptr->sensor = 8;
+    LONGS_EQUAL(8, ptr->sensor);
+}
+
+TEST(MAKE_MEMCPY_SHARED_PTR, MAKE_SHARED_PTR_COPY)
+{
+    memcpy_shared_ptr<int> ptr1 = make_memcpy_shared_ptr<int>(12);
+    {
+        memcpy_shared_ptr<int> ptr2 = ptr1;
+        LONGS_EQUAL(2, ptr1.get_count());
+        LONGS_EQUAL(12, *ptr2);
+    }
+    LONGS_EQUAL(1, ptr1.get_count());
+    LONGS_EQUAL(12, *ptr1);
+}
+
+TEST(MAKE_MEMCPY_SHARED_PTR, MAKE_SHARED_PTR_SEND_RECEIVE)
+{
+    memcpy_shared_ptr<std::string> ptr1 = make_memcpy_shared_ptr<std::string>("fused");
+    uint8_t buffer[sizeof(memcpy_shared_ptr<std::string>)];
+
+    bool sent = ptr1.memcpy_send(buffer, [](void *const dest, const memcpy_shared_ptr<std::string> *src)
+                                 { return memcpy(dest, src, sizeof(memcpy_shared_ptr<std::string>)); });
+    CHECK(sent);
+    LONGS_EQUAL(2, ptr1.get_count());
+
+    memcpy_shared_ptr<std::string> ptr2;
+    bool received = ptr2.memcpy_receive(buffer, [](memcpy_shared_ptr<std::string> *dest, const void *const src)
+                                        { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_shared_ptr<std::string>)); });
+    CHECK(received);
+    POINTERS_EQUAL(ptr1.get(), ptr2.get());
+    LONGS_EQUAL(2, ptr2.get_count());
+    STRCMP_EQUAL("fused", ptr2->c_str());
+}
+
+TEST_GROUP(MEMCPY_LOCAL_SHARED_PTR){};
+
+TEST(MEMCPY_LOCAL_SHARED_PTR, Copy_and_release)
+{
+    memcpy_local_shared_ptr<int> ptr1 = make_memcpy_local_shared_ptr<int>(4);
+    {
+        memcpy_local_shared_ptr<int> ptr2 = ptr1;
+        LONGS_EQUAL(2, ptr1.get_count());
+        LONGS_EQUAL(4, *ptr2);
+    }
+    LONGS_EQUAL(1, ptr1.get_count());
+    LONGS_EQUAL(sizeof(memcpy_shared_ptr<int>), sizeof(memcpy_local_shared_ptr<int>));
+}
+
+TEST(MEMCPY_LOCAL_SHARED_PTR, Send_receive)
+{
+    memcpy_local_shared_ptr<int> ptr1{new int(9)};
+    uint8_t buffer[sizeof(memcpy_local_shared_ptr<int>)];
+    ptr1.memcpy_send(buffer, [](void *const dest, const memcpy_local_shared_ptr<int> *src)
+                     { return memcpy(dest, src, sizeof(memcpy_local_shared_ptr<int>)); });
+    LONGS_EQUAL(2, ptr1.get_count());
+
+    memcpy_local_shared_ptr<int> ptr2;
+    ptr2.memcpy_receive(buffer, [](memcpy_local_shared_ptr<int> *dest, const void *const src)
+                        { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_local_shared_ptr<int>)); });
+    LONGS_EQUAL(2, ptr2.get_count());
+    LONGS_EQUAL(9, *ptr2);
+}
+
+TEST(MEMCPY_LOCAL_SHARED_PTR, Convert_to_atomic_when_sole_owner)
+{
+    memcpy_local_shared_ptr<int> local = make_memcpy_local_shared_ptr<int>(11);
+    int *object = local.get();
+
+    memcpy_shared_ptr<int> shared{new int(1)};
+    CHECK(local.convert_lock_policy(shared));
+    POINTERS_EQUAL(nullptr, local.get());
+    LONGS_EQUAL(0, local.get_count());
+    POINTERS_EQUAL(object, shared.get());
+    LONGS_EQUAL(1, shared.get_count());
+
+    memcpy_shared_ptr<int> copy = shared;
+    LONGS_EQUAL(2, shared.get_count());
+}
+
+TEST(MEMCPY_LOCAL_SHARED_PTR, Convert_refused_while_shared)
+{
+    memcpy_local_shared_ptr<int> local = make_memcpy_local_shared_ptr<int>(11);
+    memcpy_local_shared_ptr<int> other = local;
+
+    memcpy_shared_ptr<int> shared;
+    CHECK_FALSE(local.convert_lock_policy(shared));
+    LONGS_EQUAL(2, local.get_count());
+    POINTERS_EQUAL(nullptr, shared.get());
+}
+
+namespace
+{
+    struct RadioFrame
+    {
+        RadioFrame() { live++; }
+        ~RadioFrame() { live--; }
+        int32_t header = 1;
+        int32_t payload[4] = {10, 11, 12, 13};
+        int32_t crc = 99;
+        static int live;
+    };
+
+    int RadioFrame::live = 0;
+}
+
+TEST_GROUP(MEMCPY_SHARED_PTR_ALIAS){};
+
+TEST(MEMCPY_SHARED_PTR_ALIAS, Alias_shares_owners_and_frees_the_original)
+{
+    memcpy_shared_ptr<int32_t> crc;
+    {
+        memcpy_shared_ptr<RadioFrame> frame = make_memcpy_shared_ptr<RadioFrame>();
+        crc = memcpy_shared_ptr<int32_t>{frame, &frame->crc};
+        POINTERS_EQUAL(&frame->crc, crc.get());
+        LONGS_EQUAL(2, frame.get_count());
+        CHECK(crc.owner_equal(memcpy_shared_ptr<int32_t>{frame, nullptr}));
+    }
+    LONGS_EQUAL(1, RadioFrame::live); // Kept alive by the alias alone
+    LONGS_EQUAL(99, *crc);
+    crc = memcpy_shared_ptr<int32_t>{};
+    LONGS_EQUAL(0, RadioFrame::live);
+}
+
+TEST(MEMCPY_SHARED_PTR_ALIAS, Moving_alias_takes_the_owner_over)
+{
+    memcpy_shared_ptr<RadioFrame> frame = make_memcpy_shared_ptr<RadioFrame>();
+    int32_t *const header = &frame->header;
+    memcpy_shared_ptr<int32_t> alias{std::move(frame), header};
+    POINTERS_EQUAL(nullptr, frame.get());
+    LONGS_EQUAL(1, alias.get_count());
+    LONGS_EQUAL(1, *alias);
+}
+
+TEST(MEMCPY_SHARED_PTR_ALIAS, Member_helper_and_assignment_between_aliases)
+{
+    memcpy_shared_ptr<RadioFrame> frame = make_memcpy_shared_ptr<RadioFrame>();
+    memcpy_shared_ptr<int32_t> header = memcpy_shared_member(frame, &RadioFrame::header);
+    memcpy_shared_ptr<int32_t> crc = memcpy_shared_member(frame, &RadioFrame::crc);
+    LONGS_EQUAL(3, frame.get_count());
+
+    header = crc; // Same owners, other sub-object
+    POINTERS_EQUAL(&frame->crc, header.get());
+    LONGS_EQUAL(3, frame.get_count());
+
+    memcpy_shared_ptr<RadioFrame> empty;
+    POINTERS_EQUAL(nullptr, memcpy_shared_member(empty, &RadioFrame::crc).get());
+}
+
+TEST(MEMCPY_SHARED_PTR_ALIAS, Member_helper_decays_an_array_member)
+{
+    memcpy_shared_ptr<RadioFrame> frame = make_memcpy_shared_ptr<RadioFrame>();
+    memcpy_shared_ptr<int32_t> payload = memcpy_shared_member(frame, &RadioFrame::payload);
+    POINTERS_EQUAL(&frame->payload[0], payload.get());
+    LONGS_EQUAL(2, frame.get_count());
+}
+
+TEST(MEMCPY_SHARED_PTR_ALIAS, Send_receive_carries_the_alias)
+{
+    memcpy_shared_ptr<int32_t> payload;
+    {
+        memcpy_shared_ptr<RadioFrame> frame = make_memcpy_shared_ptr<RadioFrame>();
+        memcpy_shared_ptr<int32_t> slice{frame, &frame->payload[2]};
+
+        uint8_t buffer[sizeof(memcpy_shared_ptr<int32_t>)];
+        CHECK(slice.memcpy_send(buffer, [](void *const dest, const memcpy_shared_ptr<int32_t> *src)
+                                { return memcpy(dest, src, sizeof(memcpy_shared_ptr<int32_t>)) != nullptr; }));
+        CHECK(payload.memcpy_receive(buffer, [](memcpy_shared_ptr<int32_t> *dest, const void *const src)
+                                     { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_shared_ptr<int32_t>)) != nullptr; }));
+        POINTERS_EQUAL(slice.get(), payload.get());
+        LONGS_EQUAL(3, frame.get_count());
+    }
+    LONGS_EQUAL(12, *payload);
+    LONGS_EQUAL(1, payload.get_count());
+    payload = memcpy_shared_ptr<int32_t>{};
+    LONGS_EQUAL(0, RadioFrame::live);
+}
+
+TEST(MEMCPY_SHARED_PTR_ALIAS, Send_block_refuses_an_alias)
+{
+    memcpy_shared_ptr<RadioFrame> frame = make_memcpy_shared_ptr<RadioFrame>();
+    memcpy_shared_ptr<int32_t> crc = memcpy_shared_member(frame, &RadioFrame::crc);
+    CHECK_FALSE(crc.memcpy_send_block([](memcpy_shared_ptr_control_block *const)
+                                      { return true; }));
+    LONGS_EQUAL(2, frame.get_count());
+}
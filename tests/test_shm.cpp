@@ -0,0 +1,243 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_shm.h"
+#include "memcpy_ptr_ring.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    struct Frame
+    {
+        int32_t sequence;
+        int32_t samples[8]{};
+    };
+
+    struct Counted
+    {
+        explicit Counted(int32_t value) : value(value) {}
+        ~Counted() { destroyed++; }
+        int32_t value;
+        static int destroyed; // Process-local: only checked in the process that releases the object
+    };
+
+    int Counted::destroyed = 0;
+
+    // A unique name per test process, so parallel runs do not collide
+    struct shm_name
+    {
+        explicit shm_name(const char *tag)
+        {
+            snprintf(text, sizeof(text), "/memcpy_shm_%s_%d", tag, static_cast<int>(getpid()));
+            memcpy_shm_arena::unlink(text);
+        }
+        ~shm_name() { memcpy_shm_arena::unlink(text); }
+        char text[64];
+    };
+
+    template <class Ptr>
+    bool copy_out(void *const dest, const Ptr *src)
+    {
+        memcpy(dest, static_cast<const void *>(src), sizeof(Ptr));
+        return true;
+    }
+
+    template <class Ptr>
+    bool copy_in(Ptr *dest, const void *const src)
+    {
+        memcpy(static_cast<void *>(dest), src, sizeof(Ptr));
+        return true;
+    }
+
+    constexpr std::size_t arena_bytes = 64 * 1024;
+}
+
+TEST_GROUP(MEMCPY_SHM){};
+
+TEST(MEMCPY_SHM, Create_fails_for_an_existing_name_or_taken_id)
+{
+    shm_name name{"exists"};
+    shm_name other{"exists2"};
+    memcpy_shm_arena arena;
+    CHECK(arena.create(name.text, arena_bytes, 0));
+
+    memcpy_shm_arena same_name;
+    CHECK_FALSE(same_name.create(name.text, arena_bytes, 1));
+    memcpy_shm_arena same_id;
+    CHECK_FALSE(same_id.create(other.text, arena_bytes, 0));
+    memcpy_shm_arena reopened;
+    CHECK_FALSE(reopened.open(name.text)); // id 0 is already open in this process
+    CHECK_FALSE(reopened.open("/memcpy_shm_missing"));
+}
+
+TEST(MEMCPY_SHM, Unique_send_receive)
+{
+    shm_name name{"unique"};
+    memcpy_shm_arena arena;
+    CHECK(arena.create(name.text, arena_bytes, 0));
+
+    memcpy_shm_unique_ptr<Frame> frame = make_memcpy_shm_unique_ptr<Frame>(arena, 7);
+    CHECK(frame);
+    frame->samples[3] = 42;
+
+    unsigned char queue[sizeof(memcpy_shm_unique_ptr<Frame>)];
+    CHECK(frame.memcpy_send(queue, copy_out<memcpy_shm_unique_ptr<Frame>>));
+    CHECK_FALSE(frame);
+
+    memcpy_shm_unique_ptr<Frame> received;
+    CHECK(received.memcpy_receive(queue, copy_in<memcpy_shm_unique_ptr<Frame>>));
+    LONGS_EQUAL(7, received->sequence);
+    LONGS_EQUAL(42, received->samples[3]);
+}
+
+TEST(MEMCPY_SHM, Handle_survives_a_different_mapping_address)
+{
+    shm_name name{"remap"};
+    memcpy_shm_arena arena;
+    CHECK(arena.create(name.text, arena_bytes, 1));
+
+    unsigned char queue[sizeof(memcpy_shm_unique_ptr<Frame>)];
+    void *old_address = nullptr;
+    {
+        memcpy_shm_unique_ptr<Frame> frame = make_memcpy_shm_unique_ptr<Frame>(arena, 9);
+        old_address = frame.get();
+        CHECK(frame.memcpy_send(queue, copy_out<memcpy_shm_unique_ptr<Frame>>));
+    }
+
+    // Map it again at another address: the old range is taken by a placeholder first
+    arena.close();
+    void *const placeholder = mmap(nullptr, arena_bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    memcpy_shm_arena reopened;
+    CHECK(reopened.open(name.text));
+    LONGS_EQUAL(1, reopened.id());
+
+    memcpy_shm_unique_ptr<Frame> received;
+    received.memcpy_adopt(queue);
+    CHECK(received);
+    LONGS_EQUAL(9, received->sequence);
+    CHECK(static_cast<void *>(received.get()) != old_address);
+    munmap(placeholder, arena_bytes);
+}
+
+TEST(MEMCPY_SHM, Freed_blocks_are_reused)
+{
+    shm_name name{"reuse"};
+    memcpy_shm_arena arena;
+    CHECK(arena.create(name.text, arena_bytes, 0));
+
+    void *const first = make_memcpy_shm_unique_ptr<Frame>(arena, 1).get(); // Freed at once
+    memcpy_shm_unique_ptr<Frame> second = make_memcpy_shm_unique_ptr<Frame>(arena, 2);
+    POINTERS_EQUAL(first, second.get());
+}
+
+TEST(MEMCPY_SHM, Exhausted_arena_yields_empty_pointer)
+{
+    shm_name name{"full"};
+    memcpy_shm_arena arena;
+    CHECK(arena.create(name.text, 4096, 0));
+
+    memcpy_shm_unique_ptr<Frame> frames[128];
+    std::size_t made = 0;
+    while (made < 128 && (frames[made] = make_memcpy_shm_unique_ptr<Frame>(arena, 0)))
+    {
+        made++;
+    }
+    CHECK(made > 0);
+    CHECK(made < 128);
+}
+
+TEST(MEMCPY_SHM, Shared_send_registers_an_owner)
+{
+    shm_name name{"shared"};
+    memcpy_shm_arena arena;
+    CHECK(arena.create(name.text, arena_bytes, 0));
+    Counted::destroyed = 0;
+
+    memcpy_shm_shared_ptr<Counted> ptr = make_memcpy_shm_shared_ptr<Counted>(arena, 5);
+    LONGS_EQUAL(1, ptr.get_count());
+
+    unsigned char queue[sizeof(memcpy_shm_shared_ptr<Counted>)];
+    CHECK(ptr.memcpy_send(queue, copy_out<memcpy_shm_shared_ptr<Counted>>));
+    LONGS_EQUAL(2, ptr.get_count());
+
+    memcpy_shm_shared_ptr<Counted> received;
+    CHECK(received.memcpy_receive(queue, copy_in<memcpy_shm_shared_ptr<Counted>>));
+    POINTERS_EQUAL(ptr.get(), received.get());
+    LONGS_EQUAL(2, received.get_count());
+
+    ptr = memcpy_shm_shared_ptr<Counted>{};
+    LONGS_EQUAL(0, Counted::destroyed);
+    received = memcpy_shm_shared_ptr<Counted>{};
+    LONGS_EQUAL(1, Counted::destroyed);
+}
+
+TEST(MEMCPY_SHM, Failed_shared_send_keeps_the_count)
+{
+    shm_name name{"sharedfail"};
+    memcpy_shm_arena arena;
+    CHECK(arena.create(name.text, arena_bytes, 0));
+
+    memcpy_shm_shared_ptr<Counted> ptr = make_memcpy_shm_shared_ptr<Counted>(arena, 5);
+    unsigned char queue[sizeof(memcpy_shm_shared_ptr<Counted>)];
+    CHECK_FALSE(ptr.memcpy_send(queue, [](void *const, const memcpy_shm_shared_ptr<Counted> *const)
+                                { return false; }));
+    LONGS_EQUAL(1, ptr.get_count());
+}
+
+TEST(MEMCPY_SHM, Ring_between_processes)
+{
+    using Ring = memcpy_spsc_ring<memcpy_shm_unique_ptr<Frame>, 8>;
+    shm_name name{"fork"};
+    memcpy_shm_arena arena;
+    CHECK(arena.create(name.text, arena_bytes, 0));
+    Ring *const ring = arena.construct<Ring>();
+    CHECK(ring != nullptr);
+    arena.set_root(ring);
+
+    const pid_t child = fork();
+    if (child == 0)
+    {
+        // Consumer process: map the arena afresh by name and take everything off the ring
+        arena.close();
+        memcpy_shm_arena mine;
+        int32_t expected = 0;
+        if (mine.open(name.text))
+        {
+            Ring *const shared = mine.root<Ring>();
+            memcpy_shm_unique_ptr<Frame> frame;
+            while (expected < 4)
+            {
+                if (shared->pop(frame))
+                {
+                    if (frame->sequence != expected || frame->samples[0] != expected * 10)
+                    {
+                        break;
+                    }
+                    expected++;
+                }
+            }
+            frame.reset();
+        }
+        _exit(expected == 4 ? 0 : 1);
+    }
+    CHECK(child > 0);
+
+    for (int32_t i = 0; i < 4; i++)
+    {
+        memcpy_shm_unique_ptr<Frame> frame = make_memcpy_shm_unique_ptr<Frame>(arena, i);
+        frame->samples[0] = i * 10;
+        while (!ring->push(frame))
+        {
+        }
+    }
+
+    int status = 0;
+    CHECK(waitpid(child, &status, 0) == child);
+    CHECK(WIFEXITED(status));
+    LONGS_EQUAL(0, WEXITSTATUS(status));
+    CHECK(ring->empty());
+    arena.destroy(ring);
+}
@@ -0,0 +1,175 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_unique_pointer.h"
+#include "memcpy_shared_pointer.h"
+
+#include <cstring>
+
+namespace
+{
+    // One type per test: the counters are global per managed type
+    struct UniqueFrame
+    {
+        int value;
+    };
+
+    struct QueuedFrame
+    {
+        int value;
+    };
+
+    struct SharedFrame
+    {
+        int value;
+    };
+
+    struct BatchFrame
+    {
+        int value;
+    };
+
+    struct WindowFrame
+    {
+        int value;
+    };
+
+    struct QuietFrame
+    {
+        int value;
+    };
+}
+
+template <>
+struct memcpy_stats_enabled<QuietFrame> : std::false_type
+{
+};
+
+template <>
+struct memcpy_stats_enabled<UniqueFrame> : std::true_type
+{
+};
+
+template <>
+struct memcpy_stats_enabled<QueuedFrame> : std::true_type
+{
+};
+
+template <>
+struct memcpy_stats_enabled<SharedFrame> : std::true_type
+{
+};
+
+template <>
+struct memcpy_stats_enabled<BatchFrame> : std::true_type
+{
+};
+
+template <>
+struct memcpy_stats_enabled<WindowFrame> : std::true_type
+{
+};
+
+TEST_GROUP(MEMCPY_STATS){};
+
+TEST(MEMCPY_STATS, Disabled_type_reports_nothing)
+{
+    static_assert(!memcpy_stats<QuietFrame>::enabled, "QuietFrame opted out");
+    static_assert(memcpy_stats<int>::enabled == (MEMCPY_SMART_PTR_STATS != 0), "stats follow the build switch by default");
+    {
+        memcpy_unique_ptr<QuietFrame> ptr = make_memcpy_unique_ptr<QuietFrame>(1);
+    }
+    memcpy_stats_snapshot s = memcpy_stats<QuietFrame>::snapshot();
+    LONGS_EQUAL(0, s.allocations);
+    LONGS_EQUAL(0, s.frees);
+}
+
+TEST(MEMCPY_STATS, Unique_allocations_and_frees)
+{
+    {
+        memcpy_unique_ptr<UniqueFrame> ptr1 = make_memcpy_unique_ptr<UniqueFrame>(1);
+        memcpy_unique_ptr<UniqueFrame> ptr2 = make_memcpy_unique_ptr<UniqueFrame>(2);
+        memcpy_unique_ptr<UniqueFrame> ptr3 = std::move(ptr1); // A move is not an allocation
+        LONGS_EQUAL(2, memcpy_stats<UniqueFrame>::snapshot().live);
+    }
+    memcpy_stats_snapshot s = memcpy_stats<UniqueFrame>::snapshot();
+    LONGS_EQUAL(2, s.allocations);
+    LONGS_EQUAL(2, s.frees);
+    LONGS_EQUAL(0, s.live);
+    LONGS_EQUAL(2, s.peak_live);
+}
+
+TEST(MEMCPY_STATS, Unique_in_flight)
+{
+    memcpy_unique_ptr<QueuedFrame> ptr1 = make_memcpy_unique_ptr<QueuedFrame>(5);
+    uint8_t buffer[sizeof(memcpy_unique_ptr<QueuedFrame>)];
+
+    CHECK(ptr1.memcpy_send(buffer, [](void *const dest, const memcpy_unique_ptr<QueuedFrame> *src)
+                           { return memcpy(dest, src, sizeof(memcpy_unique_ptr<QueuedFrame>)) != nullptr; }));
+    LONGS_EQUAL(1, memcpy_stats<QueuedFrame>::snapshot().in_flight);
+    LONGS_EQUAL(1, memcpy_stats<QueuedFrame>::snapshot().live); // Parked in the buffer, not freed
+
+    memcpy_unique_ptr<QueuedFrame> ptr2;
+    CHECK(ptr2.memcpy_receive(buffer, [](memcpy_unique_ptr<QueuedFrame> *dest, const void *const src)
+                              { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_unique_ptr<QueuedFrame>)) != nullptr; }));
+    memcpy_stats_snapshot s = memcpy_stats<QueuedFrame>::snapshot();
+    LONGS_EQUAL(1, s.sends);
+    LONGS_EQUAL(1, s.receives);
+    LONGS_EQUAL(0, s.in_flight);
+}
+
+TEST(MEMCPY_STATS, Shared_counts_objects_not_owners)
+{
+    memcpy_shared_ptr<SharedFrame> ptr1 = make_memcpy_shared_ptr<SharedFrame>(3);
+    memcpy_shared_ptr<SharedFrame> ptr2 = ptr1;
+    uint8_t buffer[sizeof(memcpy_shared_ptr<SharedFrame>)];
+
+    CHECK(ptr1.memcpy_send(buffer, [](void *const dest, const memcpy_shared_ptr<SharedFrame> *src)
+                           { return memcpy(dest, src, sizeof(memcpy_shared_ptr<SharedFrame>)) != nullptr; }));
+    memcpy_stats_snapshot s = memcpy_stats<SharedFrame>::snapshot();
+    LONGS_EQUAL(1, s.allocations);
+    LONGS_EQUAL(1, s.in_flight);
+
+    memcpy_shared_ptr<SharedFrame> ptr3;
+    ptr3.memcpy_adopt(buffer);
+    LONGS_EQUAL(0, memcpy_stats<SharedFrame>::snapshot().in_flight);
+
+    ptr1 = memcpy_shared_ptr<SharedFrame>{};
+    ptr2 = memcpy_shared_ptr<SharedFrame>{};
+    LONGS_EQUAL(0, memcpy_stats<SharedFrame>::snapshot().frees);
+    ptr3 = memcpy_shared_ptr<SharedFrame>{};
+    LONGS_EQUAL(1, memcpy_stats<SharedFrame>::snapshot().frees);
+    LONGS_EQUAL(0, memcpy_stats<SharedFrame>::snapshot().live);
+}
+
+TEST(MEMCPY_STATS, Batches_count_every_pointer)
+{
+    using ptr_t = memcpy_shared_ptr<BatchFrame>;
+    ptr_t ptrs[3] = {make_memcpy_shared_ptr<BatchFrame>(1), make_memcpy_shared_ptr<BatchFrame>(2), make_memcpy_shared_ptr<BatchFrame>(3)};
+    uint8_t buffer[sizeof(ptrs)];
+
+    CHECK(ptr_t::memcpy_send_batch(ptrs, buffer, [](void *const dest, const ptr_t *src, std::size_t count)
+                                   { return memcpy(dest, src, count * sizeof(ptr_t)) != nullptr; }));
+    LONGS_EQUAL(3, memcpy_stats<BatchFrame>::snapshot().in_flight);
+
+    ptr_t received[3];
+    CHECK(ptr_t::memcpy_receive_batch(received, buffer, [](ptr_t *dest, const void *const src, std::size_t count)
+                                      { return memcpy(static_cast<void *>(dest), src, count * sizeof(ptr_t)) != nullptr; }));
+    LONGS_EQUAL(0, memcpy_stats<BatchFrame>::snapshot().in_flight);
+    LONGS_EQUAL(3, memcpy_stats<BatchFrame>::snapshot().receives);
+}
+
+TEST(MEMCPY_STATS, Reset_keeps_live_objects)
+{
+    memcpy_unique_ptr<WindowFrame> kept = make_memcpy_unique_ptr<WindowFrame>(1);
+    {
+        memcpy_unique_ptr<WindowFrame> temp = make_memcpy_unique_ptr<WindowFrame>(2);
+    }
+    memcpy_stats<WindowFrame>::reset();
+
+    memcpy_stats_snapshot s = memcpy_stats<WindowFrame>::snapshot();
+    LONGS_EQUAL(0, s.frees);
+    LONGS_EQUAL(1, s.live);
+    LONGS_EQUAL(1, s.peak_live);
+
+    kept.reset(nullptr);
+    LONGS_EQUAL(0, memcpy_stats<WindowFrame>::snapshot().live);
+}
@@ -0,0 +1,160 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_atomic_shared_pointer.h"
+#include "memcpy_ptr_ring.h"
+#include "memcpy_shared_pointer.h"
+#include "memcpy_unique_pointer.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * Host-only stress tests with real threads. They pass under AddressSanitizer as
+ * well, but are meant for a -DMEMCPY_SMART_PTR_TSAN=ON build. CppUTest checks are
+ * not thread safe, so the threads only count what went wrong and the test thread
+ * checks the totals.
+ */
+namespace
+{
+    constexpr int thread_count = 4;
+
+    struct Counted
+    {
+        explicit Counted(int value) : value(value) {}
+        ~Counted() { destroyed.fetch_add(1, std::memory_order_relaxed); }
+        int value;
+        static std::atomic<int> destroyed;
+    };
+
+    std::atomic<int> Counted::destroyed{0};
+
+    // Both words are written together, so a torn or freed snapshot shows up as a mismatch
+    struct Snapshot
+    {
+        explicit Snapshot(int version) : version(version), check(~version) {}
+        ~Snapshot() { check = 0; }
+        int version;
+        int check;
+    };
+
+    template <class Function>
+    void run_threads(int count, Function function)
+    {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < count; i++)
+        {
+            threads.emplace_back(function, i);
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+TEST_GROUP(MEMCPY_THREADS){};
+
+TEST(MEMCPY_THREADS, Shared_copies_from_many_threads_destroy_once)
+{
+    Counted::destroyed.store(0);
+    for (int round = 0; round < 20; round++)
+    {
+        memcpy_shared_ptr<Counted> *shared = new memcpy_shared_ptr<Counted>{make_memcpy_shared_ptr<Counted>(round)};
+        std::atomic<int> started{0};
+        std::atomic<int> wrong{0};
+        run_threads(thread_count, [&](int)
+                    {
+                        memcpy_shared_ptr<Counted> mine{*shared};
+                        if (started.fetch_add(1) == thread_count - 1)
+                        {
+                            delete shared; // The last thread to start drops the original owner
+                        }
+                        for (int i = 0; i < 1000; i++)
+                        {
+                            memcpy_shared_ptr<Counted> copy{mine};
+                            if (copy->value != round)
+                            {
+                                wrong.fetch_add(1);
+                            }
+                        } });
+        LONGS_EQUAL(0, wrong.load());
+        LONGS_EQUAL(round + 1, Counted::destroyed.load());
+    }
+}
+
+TEST(MEMCPY_THREADS, Mpsc_ring_delivers_every_item_once)
+{
+    constexpr int per_producer = 5000;
+    memcpy_mpsc_ring<memcpy_unique_ptr<int>, 64> ring;
+    std::atomic<bool> done{false};
+    long long received = 0;
+    long long sum = 0;
+
+    std::thread consumer([&]
+                         {
+                             memcpy_unique_ptr<int> item;
+                             for (;;)
+                             {
+                                 const bool finished = done.load(std::memory_order_acquire); // Once set, every item is already published
+                                 while (ring.pop(item))
+                                 {
+                                     received++;
+                                     sum += *item;
+                                 }
+                                 if (finished)
+                                 {
+                                     return;
+                                 }
+                             } });
+
+    run_threads(thread_count, [&](int producer)
+                {
+                    for (int i = 0; i < per_producer; i++)
+                    {
+                        memcpy_unique_ptr<int> item{new int(producer * per_producer + i)};
+                        while (!ring.push(item))
+                        {
+                            std::this_thread::yield(); // Full: the item stays with the producer
+                        }
+                    } });
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    const long long total = static_cast<long long>(thread_count) * per_producer;
+    LONGS_EQUAL(total, received);
+    LONGS_EQUAL(total * (total - 1) / 2, sum);
+}
+
+TEST(MEMCPY_THREADS, Atomic_shared_readers_see_whole_snapshots)
+{
+    constexpr int writers = 2;
+    constexpr int stores = 2000;
+    memcpy_atomic_shared_ptr<Snapshot> slot{make_memcpy_shared_ptr<Snapshot>(0)};
+    std::atomic<int> writing{writers};
+    std::atomic<int> wrong{0};
+
+    run_threads(thread_count + writers, [&](int index)
+                {
+                    if (index < writers)
+                    {
+                        for (int i = 1; i <= stores; i++)
+                        {
+                            slot.store(make_memcpy_shared_ptr<Snapshot>(index * stores + i));
+                        }
+                        writing.fetch_sub(1);
+                        return;
+                    }
+                    while (writing.load() > 0)
+                    {
+                        memcpy_shared_ptr<Snapshot> snapshot = slot.load();
+                        if (snapshot->check != ~snapshot->version)
+                        {
+                            wrong.fetch_add(1);
+                        }
+                    } });
+
+    LONGS_EQUAL(0, wrong.load());
+    memcpy_shared_ptr<Snapshot> last = slot.load();
+    LONGS_EQUAL(~last->version, last->check);
+    LONGS_EQUAL(2, last.get_count());
+}
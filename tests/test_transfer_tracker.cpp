@@ -0,0 +1,146 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_unique_pointer.h"
+#include "memcpy_shared_pointer.h"
+
+#include <cstring>
+
+namespace
+{
+    struct Packet
+    {
+        int value;
+    };
+
+    using unique_packet = memcpy_unique_ptr<Packet>;
+    using shared_packet = memcpy_shared_ptr<Packet>;
+
+    bool copy_unique_out(void *const dest, const unique_packet *src)
+    {
+        memcpy(dest, src, sizeof(unique_packet));
+        return true;
+    }
+
+    bool copy_unique_in(unique_packet *dest, const void *const src)
+    {
+        memcpy(static_cast<void *>(dest), src, sizeof(unique_packet));
+        return true;
+    }
+
+    bool copy_shared_out(void *const dest, const shared_packet *src)
+    {
+        memcpy(dest, src, sizeof(shared_packet));
+        return true;
+    }
+
+    bool copy_shared_in(shared_packet *dest, const void *const src)
+    {
+        memcpy(static_cast<void *>(dest), src, sizeof(shared_packet));
+        return true;
+    }
+}
+
+template <>
+struct memcpy_transfer_tracked<Packet> : std::true_type
+{
+};
+
+TEST_GROUP(MEMCPY_TRANSFER_TRACKER){};
+
+TEST(MEMCPY_TRANSFER_TRACKER, Layout_unchanged)
+{
+    static_assert(sizeof(unique_packet) == sizeof(Packet *), "tracking must not change the pointer layout");
+    static_assert(!memcpy_transfer_tracker<int>::enabled || MEMCPY_SMART_PTR_TRACK_TRANSFERS, "tracking must be opt-in");
+}
+
+TEST(MEMCPY_TRANSFER_TRACKER, Send_and_receive_check_off)
+{
+    const memcpy_transfer_summary before = memcpy_transfer_report();
+    unique_packet ptr1 = make_memcpy_unique_ptr<Packet>(1);
+    uint8_t buffer[sizeof(unique_packet)];
+
+    CHECK(ptr1.memcpy_send(buffer, copy_unique_out));
+    LONGS_EQUAL(before.tracked + 1, memcpy_transfer_report().tracked);
+
+    unique_packet ptr2;
+    CHECK(ptr2.memcpy_receive(buffer, copy_unique_in));
+    LONGS_EQUAL(before.tracked, memcpy_transfer_report().tracked);
+    LONGS_EQUAL(before.rejected, memcpy_transfer_report().rejected);
+    LONGS_EQUAL(1, ptr2->value);
+}
+
+TEST(MEMCPY_TRANSFER_TRACKER, Duplicate_receive_is_rejected)
+{
+    const memcpy_transfer_summary before = memcpy_transfer_report();
+    unique_packet ptr1 = make_memcpy_unique_ptr<Packet>(2);
+    uint8_t buffer[sizeof(unique_packet)];
+    CHECK(ptr1.memcpy_send(buffer, copy_unique_out));
+
+    unique_packet ptr2;
+    CHECK(ptr2.memcpy_receive(buffer, copy_unique_in));
+
+    unique_packet ptr3;
+    CHECK_FALSE(ptr3.memcpy_receive(buffer, copy_unique_in)); // Would be a second owner
+    CHECK(ptr3.get() == nullptr);
+    LONGS_EQUAL(before.rejected + 1, memcpy_transfer_report().rejected);
+
+    unique_packet ptr4 = make_memcpy_unique_ptr<Packet>(3);
+    CHECK_FALSE(ptr4.memcpy_receive(buffer, copy_unique_in)); // The current object is kept
+    LONGS_EQUAL(3, ptr4->value);
+}
+
+TEST(MEMCPY_TRANSFER_TRACKER, Orphans_are_listed)
+{
+    unique_packet ptr1 = make_memcpy_unique_ptr<Packet>(4);
+    const Packet *const object = ptr1.get();
+    uint8_t buffer[sizeof(unique_packet)];
+    CHECK(ptr1.memcpy_send(buffer, copy_unique_out));
+
+    memcpy_transfer_record records[MEMCPY_SMART_PTR_TRACK_CAPACITY];
+    const std::size_t count = memcpy_transfer_dump(records, MEMCPY_SMART_PTR_TRACK_CAPACITY);
+    bool listed = false;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (records[i].key == object)
+        {
+            listed = true;
+            LONGS_EQUAL(1, records[i].copies);
+            CHECK(records[i].sequence < memcpy_transfer_report().sequence);
+        }
+    }
+    CHECK(listed);
+
+    unique_packet ptr2;
+    ptr2.memcpy_adopt(buffer);
+    CHECK(ptr2.get() == object);
+}
+
+TEST(MEMCPY_TRANSFER_TRACKER, Shared_copies_are_counted)
+{
+    const memcpy_transfer_summary before = memcpy_transfer_report();
+    shared_packet ptr1 = make_memcpy_shared_ptr<Packet>(5);
+    uint8_t buffer1[sizeof(shared_packet)];
+    uint8_t buffer2[sizeof(shared_packet)];
+    CHECK(ptr1.memcpy_send(buffer1, copy_shared_out));
+    CHECK(ptr1.memcpy_send(buffer2, copy_shared_out));
+    LONGS_EQUAL(before.tracked + 1, memcpy_transfer_report().tracked);
+
+    shared_packet ptr2;
+    shared_packet ptr3;
+    shared_packet ptr4;
+    CHECK(ptr2.memcpy_receive(buffer1, copy_shared_in));
+    CHECK(ptr3.memcpy_receive(buffer2, copy_shared_in));
+    CHECK_FALSE(ptr4.memcpy_receive(buffer2, copy_shared_in));
+    LONGS_EQUAL(3, ptr1.get_count());
+    LONGS_EQUAL(before.tracked, memcpy_transfer_report().tracked);
+}
+
+TEST(MEMCPY_TRANSFER_TRACKER, Failed_send_is_not_in_flight)
+{
+    const memcpy_transfer_summary before = memcpy_transfer_report();
+    unique_packet ptr = make_memcpy_unique_ptr<Packet>(6);
+    uint8_t buffer[sizeof(unique_packet)];
+    CHECK_FALSE(ptr.memcpy_send(buffer, [](void *const, const unique_packet *)
+                                { return false; }));
+    LONGS_EQUAL(before.tracked, memcpy_transfer_report().tracked);
+    LONGS_EQUAL(before.rejected, memcpy_transfer_report().rejected);
+}
@@ -84,11 +84,173 @@ TEST(MEMCPY_UNIQUE_PRR, Memcpy_receive_function)
 
     memcpy_unique_ptr<int> ptr2;
     bool received = ptr2.memcpy_receive(buffer, [](memcpy_unique_ptr<int> *dest, const void *src)
-                                        { return memcpy(dest, src, sizeof(memcpy_unique_ptr<int>)); });
+                                        { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_unique_ptr<int>)); });
     CHECK(received);
     CHECK(*ptr2 == 70);
 }
 
+namespace
+{
+    int free_calls = 0;
+
+    void counting_free(void *p)
+    {
+        free_calls++;
+        ::operator delete(p);
+    }
+
+    // Stateful deleter: records the deleted value in a caller-owned slot
+    struct recording_delete
+    {
+        int *last_deleted;
+
+        void operator()(int *p) const noexcept
+        {
+            *last_deleted = *p;
+            delete p;
+        }
+    };
+}
+
+TEST(MEMCPY_UNIQUE_PRR, Stateless_deleter_adds_no_size)
+{
+    LONGS_EQUAL(sizeof(int *), sizeof(memcpy_unique_ptr<int>));
+    LONGS_EQUAL(sizeof(int *), (sizeof(memcpy_unique_ptr<int, memcpy_free_delete<int, counting_free>>)));
+}
+
+TEST(MEMCPY_UNIQUE_PRR, Free_deleter)
+{
+    free_calls = 0;
+    {
+        memcpy_unique_ptr<int, memcpy_free_delete<int, counting_free>> ptr1{new (::operator new(sizeof(int))) int(5)};
+        CHECK(*ptr1 == 5);
+        ptr1.reset(new (::operator new(sizeof(int))) int(6));
+        LONGS_EQUAL(1, free_calls);
+    }
+    LONGS_EQUAL(2, free_calls);
+}
+
+TEST(MEMCPY_UNIQUE_PRR, Stateful_deleter)
+{
+    int last_deleted = 0;
+    {
+        memcpy_unique_ptr<int, recording_delete> ptr1{new int(7), recording_delete{&last_deleted}};
+        memcpy_unique_ptr<int, recording_delete> ptr2 = std::move(ptr1);
+        POINTERS_EQUAL(&last_deleted, ptr2.get_deleter().last_deleted);
+        LONGS_EQUAL(0, last_deleted);
+    }
+    LONGS_EQUAL(7, last_deleted);
+}
+
+TEST(MEMCPY_UNIQUE_PRR, Stateful_deleter_send_receive)
+{
+    int last_deleted = 0;
+    using ptr_type = memcpy_unique_ptr<int, recording_delete>;
+    ptr_type ptr1{new int(80), recording_delete{&last_deleted}};
+    uint8_t buffer[sizeof(ptr_type)];
+
+    bool sent = ptr1.memcpy_send(buffer, [](void *dest, const ptr_type *src)
+                                 { return memcpy(dest, src, sizeof(ptr_type)); });
+    CHECK(sent);
+    CHECK(ptr1.get() == nullptr);
+
+    ptr_type ptr2{new int(90), recording_delete{&last_deleted}};
+    bool received = ptr2.memcpy_receive(buffer, [](ptr_type *dest, const void *src)
+                                        { return memcpy(static_cast<void *>(dest), src, sizeof(ptr_type)); });
+    CHECK(received);
+    LONGS_EQUAL(90, last_deleted); // Previous object went through the deleter
+    CHECK(*ptr2 == 80);
+    POINTERS_EQUAL(&last_deleted, ptr2.get_deleter().last_deleted);
+}
+
+TEST(MEMCPY_UNIQUE_PRR, Memcpy_receive_in_place_when_empty)
+{
+    memcpy_unique_ptr<int> ptr1{new int(70)};
+    uint8_t buffer[sizeof(memcpy_unique_ptr<int>)];
+    ptr1.memcpy_send(buffer, [](void *dest, const memcpy_unique_ptr<int> *src)
+                     { return memcpy(dest, src, sizeof(memcpy_unique_ptr<int>)); });
+
+    memcpy_unique_ptr<int> ptr2;
+    memcpy_unique_ptr<int> *written = nullptr;
+    bool received = ptr2.memcpy_receive(buffer, [&written](memcpy_unique_ptr<int> *dest, const void *src)
+                                        { written = dest; return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_unique_ptr<int>)); });
+    CHECK(received);
+    POINTERS_EQUAL(&ptr2, written); // No temporary buffer
+    CHECK(*ptr2 == 70);
+
+    bool failed = ptr2.memcpy_receive(buffer, [](memcpy_unique_ptr<int> *, const void *)
+                                      { return false; });
+    CHECK_FALSE(failed);
+    CHECK(*ptr2 == 70); // Failed receive leaves the current object alone
+}
+
+TEST(MEMCPY_UNIQUE_PRR, Memcpy_adopt)
+{
+    memcpy_unique_ptr<int> ptr1{new int(5)};
+    uint8_t buffer[sizeof(memcpy_unique_ptr<int>)];
+    ptr1.memcpy_send(buffer, [](void *dest, const memcpy_unique_ptr<int> *src)
+                     { return memcpy(dest, src, sizeof(memcpy_unique_ptr<int>)); });
+
+    memcpy_unique_ptr<int> ptr2{new int(6)};
+    ptr2.memcpy_adopt(buffer);
+    CHECK(*ptr2 == 5);
+}
+
+TEST(MEMCPY_UNIQUE_PRR, Memcpy_send_receive_from_isr)
+{
+    memcpy_unique_ptr<int> ptr1{new int(33)};
+    uint8_t buffer[sizeof(memcpy_unique_ptr<int>)];
+    CHECK(ptr1.memcpy_send_from_isr(buffer, [](void *dest, const memcpy_unique_ptr<int> *src)
+                                    { return memcpy(dest, src, sizeof(memcpy_unique_ptr<int>)); }));
+    CHECK(ptr1.get() == nullptr);
+
+    memcpy_unique_ptr<int> busy{new int(1)};
+    CHECK_FALSE(busy.memcpy_receive_from_isr(buffer, [](memcpy_unique_ptr<int> *dest, const void *src)
+                                             { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_unique_ptr<int>)); }));
+    CHECK(*busy == 1); // A non-empty destination is never released from an ISR
+
+    memcpy_unique_ptr<int> ptr2;
+    CHECK(ptr2.memcpy_receive_from_isr(buffer, [](memcpy_unique_ptr<int> *dest, const void *src)
+                                       { return memcpy(static_cast<void *>(dest), src, sizeof(memcpy_unique_ptr<int>)); }));
+    CHECK(*ptr2 == 33);
+}
+
+TEST(MEMCPY_UNIQUE_PRR, Memcpy_send_receive_batch)
+{
+    memcpy_unique_ptr<int> ptrs[4] = {memcpy_unique_ptr<int>{new int(1)}, memcpy_unique_ptr<int>{new int(2)},
+                                      memcpy_unique_ptr<int>{new int(3)}, memcpy_unique_ptr<int>{new int(4)}};
+    uint8_t buffer[sizeof(ptrs)];
+    int calls = 0;
+
+    bool sent = memcpy_unique_ptr<int>::memcpy_send_batch(ptrs, buffer, [&calls](void *dest, const memcpy_unique_ptr<int> *src, std::size_t count)
+                                                          { calls++; return memcpy(dest, src, count * sizeof(memcpy_unique_ptr<int>)); });
+    CHECK(sent);
+    LONGS_EQUAL(1, calls);
+    for (auto &ptr : ptrs)
+    {
+        CHECK(ptr.get() == nullptr);
+    }
+
+    memcpy_unique_ptr<int> received[4] = {memcpy_unique_ptr<int>{new int(10)}};
+    bool ok = memcpy_unique_ptr<int>::memcpy_receive_batch(received, buffer, [](memcpy_unique_ptr<int> *dest, const void *src, std::size_t count)
+                                                           { return memcpy(static_cast<void *>(dest), src, count * sizeof(memcpy_unique_ptr<int>)); });
+    CHECK(ok);
+    for (int i = 0; i < 4; i++)
+    {
+        LONGS_EQUAL(i + 1, *received[i]);
+    }
+}
+
+TEST(MEMCPY_UNIQUE_PRR, Memcpy_send_batch_failure_keeps_ownership)
+{
+    memcpy_unique_ptr<int> ptrs[2] = {memcpy_unique_ptr<int>{new int(1)}, memcpy_unique_ptr<int>{new int(2)}};
+    bool sent = memcpy_unique_ptr<int>::memcpy_send_batch(ptrs, 2, nullptr, [](void *, const memcpy_unique_ptr<int> *, std::size_t)
+                                                          { return false; });
+    CHECK_FALSE(sent);
+    CHECK(*ptrs[0] == 1);
+    CHECK(*ptrs[1] == 2);
+}
+
 TEST_GROUP(MAKE_MEMCPY_UNIQUE_PTR){};
 
 TEST(MAKE_MEMCPY_UNIQUE_PTR, MAKE_UNIQUE_PTR_INT)
@@ -99,4 +261,52 @@ TEST(MAKE_MEMCPY_UNIQUE_PTR, MAKE_UNIQUE_PTR_INT)
 TEST(MAKE_MEMCPY_UNIQUE_PTR, MAKE_UNIQUE_PTR_STRING)
 {
     memcpy_unique_ptr<std::string> ptr = make_memcpy_unique_ptr<std::string>("This is Tolulope Matthew Busoye");
-}
\ No newline at end of file
+}
+
+TEST(MAKE_MEMCPY_UNIQUE_PTR, MAKE_UNIQUE_PTR_MULTI_ARGUMENT)
+{
+    memcpy_unique_ptr<std::string> ptr = make_memcpy_unique_ptr<std::string>(3, 'a');
+    STRCMP_EQUAL("aaa", ptr->c_str());
+}
+
+namespace
+{
+    struct Sample
+    {
+        uint8_t channel;
+        int32_t value;
+    };
+
+    struct MoveOnlyFrame
+    {
+        MoveOnlyFrame(memcpy_unique_ptr<int> payload, int tag) : payload(std::move(payload)), tag(tag) {}
+        memcpy_unique_ptr<int> payload;
+        int tag;
+    };
+}
+
+TEST(MAKE_MEMCPY_UNIQUE_PTR, MAKE_UNIQUE_PTR_AGGREGATE)
+{
+    memcpy_unique_ptr<Sample> ptr = make_memcpy_unique_ptr<Sample>(uint8_t{2}, -40);
+    LONGS_EQUAL(2, ptr->channel);
+    LONGS_EQUAL(-40, ptr->value);
+}
+
+TEST(MAKE_MEMCPY_UNIQUE_PTR, MAKE_UNIQUE_PTR_FORWARDS_RVALUES)
+{
+    memcpy_unique_ptr<int> payload{new int(9)};
+    int *const raw = payload.get();
+    memcpy_unique_ptr<MoveOnlyFrame> ptr = make_memcpy_unique_ptr<MoveOnlyFrame>(std::move(payload), 4);
+    POINTERS_EQUAL(raw, ptr->payload.get());
+    LONGS_EQUAL(4, ptr->tag);
+    CHECK(payload.get() == nullptr);
+}
+
+TEST(MAKE_MEMCPY_UNIQUE_PTR, MAKE_UNIQUE_PTR_FOR_OVERWRITE)
+{
+    memcpy_unique_ptr<Sample> ptr = make_memcpy_unique_ptr_for_overwrite<Sample>();
+    CHECK(ptr.get() != nullptr);
+    ptr->channel = 1;
+    ptr->value = 7;
+    LONGS_EQUAL(7, ptr->value);
+}
@@ -0,0 +1,146 @@
+#include "CppUTest/TestHarness.h"
+#include "memcpy_shared_pointer.h"
+
+#include <cstring>
+
+namespace
+{
+    struct Tracked
+    {
+        explicit Tracked(int value) : value(value) { live++; }
+        ~Tracked() { live--; }
+        int value;
+        static int live;
+    };
+
+    int Tracked::live = 0;
+
+    struct Pair
+    {
+        int first;
+        int second;
+    };
+}
+
+TEST_GROUP(MEMCPY_WEAK_PTR){};
+
+TEST(MEMCPY_WEAK_PTR, Create_empty_weakPtr)
+{
+    memcpy_weak_ptr<int> weak;
+    CHECK_TRUE(weak.expired());
+    POINTERS_EQUAL(nullptr, weak.lock().get());
+}
+
+TEST(MEMCPY_WEAK_PTR, Lock_while_owned)
+{
+    memcpy_shared_ptr<int> owner{new int(5)};
+    memcpy_weak_ptr<int> weak{owner};
+    LONGS_EQUAL(1, owner.get_count()); // Observers do not own
+
+    memcpy_shared_ptr<int> locked = weak.lock();
+    LONGS_EQUAL(2, owner.get_count());
+    LONGS_EQUAL(5, *locked);
+}
+
+TEST(MEMCPY_WEAK_PTR, Does_not_extend_lifetime)
+{
+    memcpy_weak_ptr<Tracked> weak;
+    {
+        memcpy_shared_ptr<Tracked> owner{new Tracked(1)};
+        weak = owner;
+        LONGS_EQUAL(1, Tracked::live);
+    }
+    LONGS_EQUAL(0, Tracked::live);
+    CHECK_TRUE(weak.expired());
+    POINTERS_EQUAL(nullptr, weak.lock().get());
+}
+
+TEST(MEMCPY_WEAK_PTR, Fused_block_outlives_object)
+{
+    memcpy_weak_ptr<Tracked> weak;
+    {
+        auto owner = make_memcpy_shared_ptr<Tracked>(2);
+        weak = owner;
+        memcpy_weak_ptr<Tracked> copy{weak};
+        CHECK_FALSE(copy.expired());
+    }
+    LONGS_EQUAL(0, Tracked::live); // Object disposed, block released with 'weak'
+    CHECK_TRUE(weak.expired());
+}
+
+TEST(MEMCPY_WEAK_PTR, Memcpy_send_receive_function)
+{
+    using weak_type = memcpy_weak_ptr<int>;
+    memcpy_shared_ptr<int> owner{new int(9)};
+    weak_type weak1{owner};
+
+    uint8_t buffer[sizeof(weak_type)];
+    CHECK(weak1.memcpy_send(buffer, [](void *dest, const weak_type *src)
+                            { memcpy(dest, src, sizeof(weak_type)); return true; }));
+
+    weak_type weak2;
+    CHECK(weak2.memcpy_receive(buffer, [](weak_type *dest, const void *src)
+                               { memcpy(static_cast<void *>(dest), src, sizeof(weak_type)); return true; }));
+    LONGS_EQUAL(9, *weak2.lock());
+    LONGS_EQUAL(1, owner.get_count());
+
+    owner = memcpy_shared_ptr<int>{};
+    CHECK_TRUE(weak1.expired());
+    CHECK_TRUE(weak2.expired());
+}
+
+TEST(MEMCPY_WEAK_PTR, Convert_lock_policy_with_observer)
+{
+    memcpy_local_shared_ptr<int> local{new int(3)};
+    memcpy_shared_ptr<int> shared;
+    {
+        memcpy_weak_ptr<int, memcpy_lock_policy_single> weak{local};
+        CHECK_FALSE(local.convert_lock_policy(shared));
+    }
+    CHECK_TRUE(local.convert_lock_policy(shared));
+    LONGS_EQUAL(3, *shared);
+}
+
+TEST(MEMCPY_WEAK_PTR, Failed_send_keeps_the_observer)
+{
+    memcpy_shared_ptr<Tracked> owner = make_memcpy_shared_ptr<Tracked>(3);
+    memcpy_weak_ptr<Tracked> weak{owner};
+    owner = memcpy_shared_ptr<Tracked>{}; // Only the weak reference keeps the fused block
+
+    uint8_t buffer[sizeof(memcpy_weak_ptr<Tracked>)];
+    CHECK_FALSE(weak.memcpy_send(buffer, [](void *const, const memcpy_weak_ptr<Tracked> *const)
+                                 { return false; }));
+    CHECK_TRUE(weak.expired());
+}
+
+TEST(MEMCPY_WEAK_PTR, Receiver_may_drop_its_copy_before_send_returns)
+{
+    memcpy_shared_ptr<Tracked> owner = make_memcpy_shared_ptr<Tracked>(3);
+    memcpy_weak_ptr<Tracked> weak{owner};
+    owner = memcpy_shared_ptr<Tracked>{}; // The sender's weak reference is the last one
+
+    uint8_t buffer[sizeof(memcpy_weak_ptr<Tracked>)];
+    // The "receiver" claims and releases the observer inside the copy function, as another core could
+    CHECK(weak.memcpy_send(buffer, [](void *const dest, const memcpy_weak_ptr<Tracked> *src)
+                           {
+                               memcpy(dest, static_cast<const void *>(src), sizeof(memcpy_weak_ptr<Tracked>));
+                               memcpy_weak_ptr<Tracked> receiver;
+                               receiver.memcpy_adopt(dest);
+                               return true; }));
+    CHECK_TRUE(weak.expired());
+    POINTERS_EQUAL(nullptr, weak.lock().get());
+}
+
+TEST(MEMCPY_WEAK_PTR, Copy_assignment_between_aliases_of_one_block)
+{
+    memcpy_shared_ptr<Pair> owner = make_memcpy_shared_ptr<Pair>(1, 2);
+    memcpy_shared_ptr<int> first{owner, &owner->first};
+    memcpy_shared_ptr<int> second{owner, &owner->second};
+    memcpy_weak_ptr<int> weak_first{first};
+    memcpy_weak_ptr<int> weak_second{second};
+
+    weak_first = weak_second;
+    memcpy_shared_ptr<int> locked = weak_first.lock();
+    POINTERS_EQUAL(&owner->second, locked.get());
+    LONGS_EQUAL(2, *locked);
+}